@@ -0,0 +1,172 @@
+// ✅ 보정 커널 벤치마크: 기존 OpenCV 경로 vs SimdKernels (스칼라 / SSE4.1 / AVX2)
+//    톤 LUT 패스는 단계와 무관하게 같은 스칼라 경로 (표 조회가 SIMD 셔플보다 빠름)
+//    사용법: enhancement_benchmark [--single-thread] [--runs N]
+//    --single-thread: OpenCV 내부 병렬화 끔 (저전력 PC 환경 비교용)
+
+#include "simdkernels.h"
+#include "tonelut.h"
+
+#include <QImage>
+#include <QElapsedTimer>
+#include <QByteArray>
+
+#include <opencv2/opencv.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace {
+
+int runs = 20;
+
+// 중앙값 (ms)
+double measure(const std::function<void()> &fn)
+{
+    fn();   // 워밍업 (버퍼 할당 등)
+    std::vector<double> samples;
+    samples.reserve(runs);
+    for (int i = 0; i < runs; ++i) {
+        QElapsedTimer timer;
+        timer.start();
+        fn();
+        samples.push_back(timer.nsecsElapsed() / 1e6);
+    }
+    std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+    return samples[samples.size() / 2];
+}
+
+// 카메라 스냅샷 비슷한 입력: 완만한 그라디언트 + 잡음
+QImage makeInput(int w, int h)
+{
+    QImage image(w, h, QImage::Format_RGB32);
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> noise(-12, 12);
+    for (int y = 0; y < h; ++y) {
+        QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+        for (int x = 0; x < w; ++x) {
+            int r = std::clamp(x * 255 / w + noise(rng), 0, 255);
+            int g = std::clamp(y * 255 / h + noise(rng), 0, 255);
+            int b = std::clamp(((x + y) / 8 % 2) * 120 + 60 + noise(rng), 0, 255);
+            line[x] = qRgb(r, g, b);
+        }
+    }
+    return image;
+}
+
+cv::Mat toMat(const QImage &image)
+{
+    // 기존 ImageEnhancer와 같은 RGB888 입력
+    QImage rgb = image.convertToFormat(QImage::Format_RGB888);
+    cv::Mat mat(rgb.height(), rgb.width(), CV_8UC3, const_cast<uchar *>(rgb.constBits()), rgb.bytesPerLine());
+    return mat.clone();
+}
+
+void printRow(const char *name, double openCvMs, const std::vector<double> &simdMs)
+{
+    std::printf("  %-16s %10.2f", name, openCvMs);
+    for (double ms : simdMs)
+        std::printf(" %10.2f (x%4.1f)", ms, openCvMs / ms);
+    std::printf("\n");
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--single-thread") == 0)
+            cv::setNumThreads(1);
+        else if (std::strcmp(argv[i], "--runs") == 0 && i + 1 < argc)
+            runs = std::max(1, std::atoi(argv[++i]));
+    }
+
+    using SimdKernels::Level;
+    std::vector<Level> levels;
+    for (Level level : {Level::Scalar, Level::SSE41, Level::AVX2}) {
+        if (level <= SimdKernels::detectedLevel())
+            levels.push_back(level);
+    }
+
+    std::printf("CPU: %s | OpenCV 스레드: %d | 반복: %d (중앙값, ms)\n\n",
+                SimdKernels::levelName(SimdKernels::detectedLevel()), cv::getNumThreads(), runs);
+
+    const QSize sizes[] = {QSize(640, 480), QSize(1280, 720), QSize(1920, 1080)};
+    for (const QSize &size : sizes) {
+        const QImage input = makeInput(size.width(), size.height());
+        const cv::Mat mat = toMat(input);
+
+        std::printf("%dx%d\n  %-16s %10s", size.width(), size.height(), "", "OpenCV");
+        for (Level level : levels)
+            std::printf(" %18s", SimdKernels::levelName(level));
+        std::printf("\n");
+
+        // 1) sigma 3 가우시안 블러 (샤프닝 기반)
+        cv::Mat cvBlur;
+        double cvMs = measure([&]() { cv::GaussianBlur(mat, cvBlur, cv::Size(0, 0), 3); });
+        std::vector<double> simd;
+        QImage blurred;
+        for (Level level : levels) {
+            SimdKernels::forceLevel(level);
+            simd.push_back(measure([&]() { SimdKernels::gaussianBlur(input, blurred, 0, 3); }));
+        }
+        printRow("gaussian s=3", cvMs, simd);
+
+        // 2) 언샤프 합성 (level +50 → alpha 2.0)
+        cv::Mat cvSharp;
+        cvMs = measure([&]() { cv::addWeighted(mat, 2.0, cvBlur, -1.0, 0, cvSharp); });
+        simd.clear();
+        QImage sharpened;
+        for (Level level : levels) {
+            SimdKernels::forceLevel(level);
+            simd.push_back(measure([&]() { SimdKernels::unsharpBlend(input, blurred, sharpened, 2.0); }));
+        }
+        printRow("unsharp blend", cvMs, simd);
+
+        // 3) 대비 (level +100 → clipLimit 7): Lab L 채널 CLAHE vs 밝기 CLAHE
+        cv::Ptr<cv::CLAHE> clahe = cv::createCLAHE(7, cv::Size(8, 8));
+        cv::Mat cvContrast;
+        cvMs = measure([&]() {
+            cv::Mat lab;
+            cv::cvtColor(mat, lab, cv::COLOR_RGB2Lab);
+            std::vector<cv::Mat> planes;
+            cv::split(lab, planes);
+            clahe->apply(planes[0], planes[0]);
+            cv::merge(planes, lab);
+            cv::cvtColor(lab, cvContrast, cv::COLOR_Lab2RGB);
+        });
+        simd.clear();
+        QImage contrasted;
+        for (Level level : levels) {
+            SimdKernels::forceLevel(level);
+            simd.push_back(measure([&]() { SimdKernels::claheLuma(input, contrasted, 7); }));
+        }
+        printRow("CLAHE", cvMs, simd);
+
+        // 4) 톤 (감마 1.5, 밝기 +10, 대비 +20): float 연산 vs 캐시된 8비트 LUT 1패스
+        cv::Mat cvTone;
+        cvMs = measure([&]() {
+            cv::Mat f;
+            mat.convertTo(f, CV_32F, 1.0 / 255);
+            cv::pow(f, 1.0 / 1.5, f);
+            f.convertTo(cvTone, CV_8U, 255 * 1.2, 10 * 1.28 - 0.5 * 255 * 0.2);
+        });
+        const ToneLut::Table table = ToneLut::lookup(1.5, 10, 20);
+        SimdKernels::ChannelLut lut;
+        std::memcpy(lut.b, table.v, sizeof(table.v));
+        std::memcpy(lut.g, table.v, sizeof(table.v));
+        std::memcpy(lut.r, table.v, sizeof(table.v));
+        simd.clear();
+        QImage toned;
+        for (Level level : levels) {
+            SimdKernels::forceLevel(level);
+            simd.push_back(measure([&]() { SimdKernels::applyLut(input, toned, lut); }));
+        }
+        printRow("tone LUT", cvMs, simd);
+        std::printf("\n");
+    }
+    return 0;
+}
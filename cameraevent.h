@@ -0,0 +1,47 @@
+#ifndef CAMERAEVENT_H
+#define CAMERAEVENT_H
+
+#include <QString>
+#include <QMetaType>
+
+// ✅ WebSocket 메시지를 수신 스레드에서 미리 파싱해 둔 이벤트
+struct CameraEvent {
+    enum class Type {
+        Detection,      // new_detection
+        Trespass,       // new_trespass
+        Blur,           // new_blur
+        Fall,           // new_fall
+        AnomalyStatus,  // anomaly_status
+        StmStatus,      // stm_status_update
+        ModeChangeAck,  // mode_change_ack
+        Log,            // log
+        Unknown
+    };
+
+    Type type = Type::Unknown;
+    QString typeName;      // 원본 type 문자열 (로그 출력용)
+
+    QString cameraIp;
+    QString cameraName;
+
+    // 실시간 로그용 (수신 스레드에서 문자열까지 완성)
+    QString function;      // "PPE", "Trespass", "Fall", "Blur", "Sound" ...
+    QString event;
+    QString details;
+    QString imagePath;
+    QString timestamp;
+
+    bool ppeViolation = false;  // Detection 전용
+    int count = 0;              // Trespass / Fall / Blur 인원 수
+
+    // anomaly_status / mode_change_ack
+    QString status;
+    QString mode;
+    QString message;
+
+    qint64 parseNsecs = 0;      // 수신 스레드에서 파싱에 걸린 시간
+};
+
+Q_DECLARE_METATYPE(CameraEvent)
+
+#endif // CAMERAEVENT_H
@@ -0,0 +1,119 @@
+#include "enhancementcontroller.h"
+#include "enhancersession.h"
+
+struct EnhancementController::Sessions {
+    QImage source;
+    std::unique_ptr<EnhancerSession> full;      // 원본 해상도 (처음 필요할 때 생성)
+    std::unique_ptr<EnhancerSession> preview;   // 표시 크기
+};
+
+EnhancementController::EnhancementController(const QSize &displaySize, QObject *parent)
+    : QObject(parent), displaySize(displaySize)
+{
+    workerPool.setMaxThreadCount(1);
+}
+
+EnhancementController::~EnhancementController()
+{
+    // 실행 중인 작업이 this로 결과를 보내기 전에 소멸되지 않도록 대기
+    pending.reset();
+    workerPool.waitForDone();
+}
+
+void EnhancementController::setImage(const QImage &image)
+{
+    ++generation;
+    pending.reset();
+    lastFull = QImage();
+
+    sessions.reset();
+    if (image.isNull()) return;
+
+    sessions = std::make_shared<Sessions>();
+    sessions->source = image;
+}
+
+void EnhancementController::clear()
+{
+    setImage(QImage());
+}
+
+bool EnhancementController::hasImage() const
+{
+    return sessions != nullptr;
+}
+
+void EnhancementController::requestPreview(int sharpLevel, int contrastLevel)
+{
+    submit({false, sharpLevel, contrastLevel});
+}
+
+void EnhancementController::requestFull(int sharpLevel, int contrastLevel)
+{
+    submit({true, sharpLevel, contrastLevel});
+}
+
+void EnhancementController::submit(const Job &job)
+{
+    if (!sessions) return;
+
+    // 실행 중이면 최신 요청 1개만 남김
+    if (busy) {
+        pending = job;
+        return;
+    }
+    startJob(job);
+}
+
+void EnhancementController::startJob(const Job &job)
+{
+    busy = true;
+
+    // 같은 세션을 두 스레드가 동시에 건드리지 않도록 작업은 항상 1개씩
+    std::shared_ptr<Sessions> target = sessions;
+    const quint64 jobGeneration = generation;
+    const QSize size = displaySize;
+
+    workerPool.start([=]() {
+        QImage display;
+        QImage full;
+
+        if (job.full) {
+            if (!target->full)
+                target->full = std::make_unique<EnhancerSession>(target->source);
+            full = target->full->render(job.sharpLevel, job.contrastLevel);
+            display = full.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        } else {
+            if (!target->preview) {
+                QImage small = target->source.size().boundedTo(size) == target->source.size()
+                                   ? target->source
+                                   : target->source.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+                target->preview = std::make_unique<EnhancerSession>(small);
+            }
+            display = target->preview->render(job.sharpLevel, job.contrastLevel);
+        }
+
+        // 소멸자에서 작업 완료를 기다리므로 this는 유효, 아직 처리 안 된 호출은 소멸 시 버려짐
+        QMetaObject::invokeMethod(this, [=]() {
+            onJobDone(jobGeneration, job, display, full);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void EnhancementController::onJobDone(quint64 jobGeneration, const Job &job, const QImage &display,
+                                      const QImage &full)
+{
+    busy = false;
+
+    if (jobGeneration == generation) {
+        if (job.full) lastFull = full;
+
+        emit rendered(display, job.full);
+    }
+
+    if (pending && sessions) {
+        Job next = *pending;
+        pending.reset();
+        startJob(next);
+    }
+}
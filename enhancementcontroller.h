@@ -0,0 +1,57 @@
+#ifndef ENHANCEMENTCONTROLLER_H
+#define ENHANCEMENTCONTROLLER_H
+
+#include <QObject>
+#include <QImage>
+#include <QSize>
+#include <QThreadPool>
+
+#include <memory>
+#include <optional>
+
+// ✅ 샤프닝/대비 보정을 작업 스레드에서 실행 (UI 스레드 멈춤 방지)
+//    - 한 번에 1개만 실행, 대기 중인 요청은 최신 값 1개만 유지 (중간 값은 버림)
+//    - 드래그 중에는 표시 크기(예: 320x240)로 축소한 이미지로 처리
+//    - 슬라이더를 놓았을 때만 원본 해상도로 처리 후 표시 크기로 축소
+class EnhancementController : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit EnhancementController(const QSize &displaySize, QObject *parent = nullptr);
+    ~EnhancementController();
+
+    void setImage(const QImage &image);     // 새 원본 (진행 중이던 이전 이미지 결과는 버림)
+    void clear();
+    bool hasImage() const;
+
+    void requestPreview(int sharpLevel, int contrastLevel);   // 드래그 중
+    void requestFull(int sharpLevel, int contrastLevel);      // 놓았을 때 / 저장 전
+
+    QImage fullResult() const { return lastFull; }   // 마지막 원본 해상도 결과
+
+signals:
+    void rendered(const QImage &display, bool fullResolution);
+
+private:
+    struct Job {
+        bool full;
+        int sharpLevel;
+        int contrastLevel;
+    };
+    struct Sessions;
+
+    void submit(const Job &job);
+    void startJob(const Job &job);
+    void onJobDone(quint64 jobGeneration, const Job &job, const QImage &display, const QImage &full);
+
+    QSize displaySize;
+    QThreadPool workerPool;               // 스레드 1개 (세션을 동시에 건드리지 않음)
+    std::shared_ptr<Sessions> sessions;   // 이미지 교체 후에도 실행 중인 작업이 안전하게 사용
+    quint64 generation = 0;               // setImage/clear마다 증가 → 이전 결과 무시
+    bool busy = false;
+    std::optional<Job> pending;
+    QImage lastFull;
+};
+
+#endif // ENHANCEMENTCONTROLLER_H
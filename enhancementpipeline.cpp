@@ -0,0 +1,322 @@
+#include "enhancementpipeline.h"
+#include "simdkernels.h"
+#include "tonelut.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using SimdKernels::ChannelLut;
+
+namespace {
+
+// 레벨 → 파라미터 환산 (기존 ImageEnhancer와 동일)
+constexpr double kSharpenSigma = 3.0;
+
+double sharpenAlpha(int level) { return 1.0 + level / 50.0; }
+int sharpenBlurKsize(int level) { return std::max(1, -level / 10 * 2 + 1); }
+int claheClipLimit(int level) { return std::min(2 + level / 20, 10); }
+int contrastBlurKsize(int level) { return std::max(1, -level / 20 * 2 + 1); }
+
+uint8_t clampByte(double v)
+{
+    return uint8_t(std::clamp(std::lround(v), 0L, 255L));
+}
+
+// 감마/밝기/대비 표는 ToneLut (컴파일 시 생성 또는 캐시), 세 채널에 같은 표
+ChannelLut toneLut(double gamma, int brightness, int contrast)
+{
+    const ToneLut::Table table = ToneLut::lookup(gamma, brightness, contrast);
+    ChannelLut lut;
+    std::memcpy(lut.b, table.v, sizeof(table.v));
+    std::memcpy(lut.g, table.v, sizeof(table.v));
+    std::memcpy(lut.r, table.v, sizeof(table.v));
+    return lut;
+}
+
+ChannelLut gainLut(const double gains[3])
+{
+    ChannelLut lut;
+    for (int v = 0; v < 256; ++v) {
+        lut.r[v] = clampByte(v * gains[0]);
+        lut.g[v] = clampByte(v * gains[1]);
+        lut.b[v] = clampByte(v * gains[2]);
+    }
+    return lut;
+}
+
+// lut = next(lut(v))
+void composeInto(ChannelLut &lut, const ChannelLut &next)
+{
+    for (int v = 0; v < 256; ++v) {
+        lut.b[v] = next.b[lut.b[v]];
+        lut.g[v] = next.g[lut.g[v]];
+        lut.r[v] = next.r[lut.r[v]];
+    }
+}
+
+// 그레이 월드: 채널 평균이 같아지도록 이득 계산 (4x4 간격 표본)
+void grayWorldGains(const QImage &image, double gains[3])
+{
+    double sum[3] = {0, 0, 0};
+    qint64 count = 0;
+    for (int y = 0; y < image.height(); y += 4) {
+        const uchar *row = image.constScanLine(y);
+        for (int x = 0; x < image.width(); x += 4) {
+            const uchar *p = row + x * 4;   // B, G, R, A
+            sum[0] += p[2];
+            sum[1] += p[1];
+            sum[2] += p[0];
+            ++count;
+        }
+    }
+    if (count == 0) return;
+
+    const double gray = (sum[0] + sum[1] + sum[2]) / 3.0;
+    for (int c = 0; c < 3; ++c)
+        gains[c] = sum[c] > 0 ? std::clamp(gray / sum[c], 0.5, 2.0) : 1.0;
+}
+
+// 가장자리 보존 잡음 제거 (양방향 필터, RGB32 버퍼를 그대로 감싸서 사용)
+QImage denoiseImage(const QImage &src, int strength, const ChannelLut *post)
+{
+    cv::Mat bgra(src.height(), src.width(), CV_8UC4, const_cast<uchar *>(src.constBits()), src.bytesPerLine());
+    cv::Mat bgr;
+    cv::cvtColor(bgra, bgr, cv::COLOR_BGRA2BGR);
+
+    cv::Mat filtered;
+    const int diameter = strength > 60 ? 7 : 5;
+    cv::bilateralFilter(bgr, filtered, diameter, 10.0 + strength * 0.7, 3.0 + strength * 0.04);
+
+    QImage out(src.size(), QImage::Format_RGB32);
+    cv::Mat outMat(out.height(), out.width(), CV_8UC4, out.bits(), out.bytesPerLine());
+    cv::cvtColor(filtered, outMat, cv::COLOR_BGR2BGRA);   // 크기/형식이 같아서 out 버퍼에 직접 기록
+
+    if (post) SimdKernels::applyLut(out, out, *post);
+    return out;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// StageCache
+// ---------------------------------------------------------------------------
+
+const QImage *EnhancementPipeline::StageCache::find(const QString &key)
+{
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        if (it->first == key) {
+            entries.splice(entries.begin(), entries, it);
+            return &entries.front().second;
+        }
+    }
+    return nullptr;
+}
+
+const QImage &EnhancementPipeline::StageCache::insert(const QString &key, const QImage &image)
+{
+    entries.emplace_front(key, image);
+    while (int(entries.size()) > limit)
+        entries.pop_back();
+    return entries.front().second;
+}
+
+// ---------------------------------------------------------------------------
+// 단계 추가 (효과 없는 값은 생략)
+// ---------------------------------------------------------------------------
+
+EnhancementPipeline &EnhancementPipeline::sharpen(int level)
+{
+    level = std::clamp(level, -100, 100);
+    if (level != 0) {
+        Stage stage{Kind::Sharpen};
+        stage.level = level;
+        stages.append(stage);
+    }
+    return *this;
+}
+
+EnhancementPipeline &EnhancementPipeline::localContrast(int level)
+{
+    level = std::clamp(level, -100, 100);
+    if (level != 0) {
+        Stage stage{Kind::LocalContrast};
+        stage.level = level;
+        stages.append(stage);
+    }
+    return *this;
+}
+
+EnhancementPipeline &EnhancementPipeline::denoise(int strength)
+{
+    strength = std::clamp(strength, 0, 100);
+    if (strength != 0) {
+        Stage stage{Kind::Denoise};
+        stage.level = strength;
+        stages.append(stage);
+    }
+    return *this;
+}
+
+EnhancementPipeline &EnhancementPipeline::tone(double gamma, int brightness, int contrast)
+{
+    if (gamma != 1.0 || brightness != 0 || contrast != 0) {
+        Stage stage{Kind::Tone};
+        stage.gamma = gamma;
+        stage.level = brightness;
+        stage.contrast = contrast;
+        stages.append(stage);
+    }
+    return *this;
+}
+
+EnhancementPipeline &EnhancementPipeline::whiteBalance()
+{
+    Stage stage{Kind::WhiteBalance};
+    stage.automatic = true;
+    stages.append(stage);
+    return *this;
+}
+
+EnhancementPipeline &EnhancementPipeline::whiteBalance(double red, double green, double blue)
+{
+    if (red != 1.0 || green != 1.0 || blue != 1.0) {
+        Stage stage{Kind::WhiteBalance};
+        stage.gains[0] = red;
+        stage.gains[1] = green;
+        stage.gains[2] = blue;
+        stages.append(stage);
+    }
+    return *this;
+}
+
+QString EnhancementPipeline::Stage::key() const
+{
+    switch (kind) {
+    case Kind::Sharpen: return QString("S%1").arg(level);
+    case Kind::LocalContrast: return QString("C%1").arg(level);
+    case Kind::Denoise: return QString("D%1").arg(level);
+    case Kind::Tone: return QString("T%1,%2,%3").arg(gamma, 0, 'f', 3).arg(level).arg(contrast);
+    case Kind::WhiteBalance:
+        if (automatic) return "Wauto";
+        return QString("W%1,%2,%3").arg(gains[0], 0, 'f', 3).arg(gains[1], 0, 'f', 3).arg(gains[2], 0, 'f', 3);
+    }
+    return QString();
+}
+
+QString EnhancementPipeline::signature() const
+{
+    QStringList keys;
+    for (const Stage &stage : stages)
+        keys.append(stage.key());
+    return keys.join(';');
+}
+
+// ---------------------------------------------------------------------------
+// 실행
+// ---------------------------------------------------------------------------
+
+QImage EnhancementPipeline::apply(const QImage &source, StageCache *cache) const
+{
+    QImage input = source.format() == QImage::Format_RGB32 ? source : source.convertToFormat(QImage::Format_RGB32);
+    if (input.isNull() || stages.isEmpty()) return input;
+
+    // 1) 공간 단계마다 Op 1개, 뒤따르는 픽셀 단위 단계는 그 Op의 LUT로 합침
+    struct Op {
+        const Stage *spatial = nullptr;   // nullptr이면 맨 앞 LUT 단독 패스
+        bool hasLut = false;
+        ChannelLut lut;
+        QString key;                      // 이 Op 출력까지의 누적 키 (캐시용)
+    };
+    std::vector<Op> ops;
+    QString prefix;
+    bool haveAutoGains = false;
+    double autoGains[3] = {1.0, 1.0, 1.0};
+
+    for (const Stage &stage : stages) {
+        if (stage.isPointwise()) {
+            if (ops.empty()) ops.push_back(Op());
+
+            ChannelLut stageLut;
+            if (stage.kind == Kind::Tone) {
+                stageLut = toneLut(stage.gamma, stage.level, stage.contrast);
+            } else if (stage.automatic) {
+                if (!haveAutoGains) {
+                    grayWorldGains(input, autoGains);   // 공간 단계는 채널 평균을 거의 바꾸지 않음
+                    haveAutoGains = true;
+                }
+                stageLut = gainLut(autoGains);
+            } else {
+                stageLut = gainLut(stage.gains);
+            }
+
+            Op &op = ops.back();
+            if (op.hasLut) {
+                composeInto(op.lut, stageLut);
+            } else {
+                op.lut = stageLut;
+                op.hasLut = true;
+            }
+        } else {
+            Op op;
+            op.spatial = &stage;
+            ops.push_back(op);
+        }
+        prefix += stage.key() + ';';
+        ops.back().key = prefix;
+    }
+
+    // 2) 캐시에 있는 가장 뒤쪽 중간 결과부터 시작 (마지막 Op 출력은 캐시하지 않음)
+    QImage current = input;
+    size_t start = 0;
+    if (cache) {
+        for (size_t i = ops.size() - 1; i-- > 0;) {
+            if (const QImage *hit = cache->find(ops[i].key)) {
+                current = *hit;
+                start = i + 1;
+                break;
+            }
+        }
+    }
+
+    for (size_t i = start; i < ops.size(); ++i) {
+        const Op &op = ops[i];
+        const ChannelLut *post = op.hasLut ? &op.lut : nullptr;
+        QImage next;
+
+        if (!op.spatial) {
+            SimdKernels::applyLut(current, next, op.lut);
+        } else if (op.spatial->kind == Kind::Sharpen) {
+            const int level = op.spatial->level;
+            if (level > 0) {
+                // 블러 기반은 샤프닝 강도와 무관 → 캐시해 두면 강도 변경 시 합성만 다시 계산
+                const QString baseKey = (i == 0 ? QString("src;") : ops[i - 1].key) + "blur";
+                const QImage *blurred = cache ? cache->find(baseKey) : nullptr;
+                QImage computed;
+                if (!blurred) {
+                    SimdKernels::gaussianBlur(current, computed, 0, kSharpenSigma);
+                    blurred = cache ? &cache->insert(baseKey, computed) : &computed;
+                }
+                SimdKernels::unsharpBlend(current, *blurred, next, sharpenAlpha(level), post);
+            } else {
+                SimdKernels::gaussianBlur(current, next, sharpenBlurKsize(level), 0, post);
+            }
+        } else if (op.spatial->kind == Kind::LocalContrast) {
+            const int level = op.spatial->level;
+            if (level > 0)
+                SimdKernels::claheLuma(current, next, claheClipLimit(level), 8, post);
+            else
+                SimdKernels::gaussianBlur(current, next, contrastBlurKsize(level), 0, post);
+        } else {
+            next = denoiseImage(current, op.spatial->level, post);
+        }
+
+        if (cache && i + 1 < ops.size())
+            cache->insert(op.key, next);
+        current = next;
+    }
+    return current;
+}
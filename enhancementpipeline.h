@@ -0,0 +1,75 @@
+#ifndef ENHANCEMENTPIPELINE_H
+#define ENHANCEMENTPIPELINE_H
+
+#include <QImage>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <list>
+#include <utility>
+
+// ✅ 이미지 보정 파이프라인 (단계를 선언적으로 나열 → 한 번에 실행)
+//
+//    EnhancementPipeline()
+//        .whiteBalance()
+//        .localContrast(40)
+//        .sharpen(30)
+//        .tone(1.2, 10, 0)
+//        .apply(image);
+//
+//    - 공간 단계(sharpen / localContrast / denoise)는 각각 1패스
+//    - 픽셀 단위 단계(tone / whiteBalance)는 채널별 LUT 하나로 합쳐서
+//      직전 공간 단계의 출력 패스에 융합 (앞에 공간 단계가 없으면 LUT 1패스)
+//    - 레벨 범위와 의미는 기존 ImageEnhancer와 동일 (-100 ~ +100, 0이면 생략)
+class EnhancementPipeline
+{
+public:
+    // 중간 결과 캐시 (슬라이더 조작처럼 뒤쪽 단계만 바뀌는 경우 앞 단계 재사용)
+    // 스레드 안전하지 않음: 한 번에 한 스레드에서만 사용
+    class StageCache {
+    public:
+        explicit StageCache(int limit = 8) : limit(limit) {}
+        void clear() { entries.clear(); }
+
+    private:
+        friend class EnhancementPipeline;
+        const QImage *find(const QString &key);
+        const QImage &insert(const QString &key, const QImage &image);
+
+        int limit;
+        std::list<std::pair<QString, QImage>> entries;   // 최근 사용 순
+    };
+
+    EnhancementPipeline &sharpen(int level);                   // 양수: 언샤프 / 음수: 블러
+    EnhancementPipeline &localContrast(int level);             // 양수: CLAHE / 음수: 약한 블러
+    EnhancementPipeline &denoise(int strength);                // 0 ~ 100, 가장자리 보존 잡음 제거
+    EnhancementPipeline &tone(double gamma, int brightness, int contrast);  // LUT (감마 / 밝기 -100~100 / 대비 -100~100)
+    EnhancementPipeline &whiteBalance();                       // 자동 (그레이 월드, 입력 이미지 통계 기준)
+    EnhancementPipeline &whiteBalance(double red, double green, double blue);  // 수동 채널 이득
+
+    bool isEmpty() const { return stages.isEmpty(); }
+    QString signature() const;   // 캐시 키 / 디버그용
+
+    // 결과 형식은 항상 Format_RGB32
+    QImage apply(const QImage &source, StageCache *cache = nullptr) const;
+
+private:
+    enum class Kind { Sharpen, LocalContrast, Denoise, Tone, WhiteBalance };
+
+    struct Stage {
+        Kind kind;
+        int level = 0;              // Sharpen / LocalContrast / Denoise / Tone 밝기
+        int contrast = 0;           // Tone
+        double gamma = 1.0;         // Tone
+        bool automatic = false;     // WhiteBalance
+        double gains[3] = {1.0, 1.0, 1.0};   // WhiteBalance (R, G, B)
+
+        bool isPointwise() const { return kind == Kind::Tone || kind == Kind::WhiteBalance; }
+        QString key() const;
+    };
+
+    QVector<Stage> stages;
+};
+
+#endif // ENHANCEMENTPIPELINE_H
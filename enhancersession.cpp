@@ -0,0 +1,22 @@
+#include "enhancersession.h"
+
+EnhancerSession::EnhancerSession(const QImage &image)
+    : source(image.convertToFormat(QImage::Format_RGB32))
+{
+}
+
+EnhancementPipeline EnhancerSession::sliderPipeline(int sharpLevel, int contrastLevel)
+{
+    return EnhancementPipeline().localContrast(contrastLevel).sharpen(sharpLevel);
+}
+
+QImage EnhancerSession::render(int sharpLevel, int contrastLevel)
+{
+    return render(sliderPipeline(sharpLevel, contrastLevel));
+}
+
+QImage EnhancerSession::render(const EnhancementPipeline &pipeline)
+{
+    if (isNull()) return QImage();
+    return pipeline.apply(source, &cache);
+}
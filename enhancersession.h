@@ -0,0 +1,33 @@
+#ifndef ENHANCERSESSION_H
+#define ENHANCERSESSION_H
+
+#include "enhancementpipeline.h"
+
+#include <QImage>
+
+// ✅ 이미지 한 장에 대한 보정 세션 (샤프닝 + 대비)
+//    파이프라인 중간 결과(대비 단계별 결과, 그 블러)를 캐시해 두고
+//    슬라이더가 움직이면 마지막 합성 패스만 다시 계산
+//    처리 순서: 대비 → 샤프닝 (샤프닝이 마지막 단계여야 블러 재사용 가능)
+class EnhancerSession {
+public:
+    explicit EnhancerSession(const QImage &image);
+
+    EnhancerSession(const EnhancerSession &) = delete;
+    EnhancerSession &operator=(const EnhancerSession &) = delete;
+
+    bool isNull() const { return source.isNull(); }
+    QSize size() const { return source.size(); }
+
+    // sharpLevel / contrastLevel: -100 ~ +100 (ImageEnhancer와 같은 의미)
+    QImage render(int sharpLevel, int contrastLevel);
+    QImage render(const EnhancementPipeline &pipeline);
+
+    static EnhancementPipeline sliderPipeline(int sharpLevel, int contrastLevel);
+
+private:
+    QImage source;   // Format_RGB32
+    EnhancementPipeline::StageCache cache{6};
+};
+
+#endif // ENHANCERSESSION_H
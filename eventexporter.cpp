@@ -0,0 +1,367 @@
+#include "eventexporter.h"
+#include "imagecache.h"
+#include "networkclient.h"
+#include "zipwriter.h"
+
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLocale>
+#include <QMutex>
+#include <QNetworkReply>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QSemaphore>
+#include <QStringList>
+#include <QTemporaryFile>
+#include <QUrl>
+#include <QDebug>
+
+#include <atomic>
+#include <deque>
+
+namespace {
+constexpr int rowChunk = 512;
+constexpr int waitMs = 100;   // 대기 중에도 이 간격으로 취소 확인
+constexpr int recentImageCount = 64;
+
+QByteArray csvField(const QString &text)
+{
+    QByteArray bytes = text.toUtf8();
+    if (bytes.contains(',') || bytes.contains('"') || bytes.contains('\n') || bytes.contains('\r')) {
+        bytes.replace("\"", "\"\"");
+        bytes.prepend('"');
+        bytes.append('"');
+    }
+    return bytes;
+}
+
+// images/<순번>_<파일명> (순번이 안정적이라 같은 파일명끼리도 겹치지 않음)
+QString imageEntryName(quint64 seq, const QString &url)
+{
+    static const QRegularExpression unsafe("[^A-Za-z0-9._-]");
+    QString base = QUrl(url).fileName();
+    base.replace(unsafe, "_");
+    if (base.isEmpty()) base = "image.jpg";
+    return QString("images/%1_%2").arg(seq).arg(base);
+}
+}
+
+struct EventExporter::Job {
+    Options options;
+    qint64 expectedRows = -1;
+    ImageCache *cache = nullptr;
+
+    std::atomic<bool> cancelled{false};
+    std::atomic<qint64> rows{0};
+    std::atomic<int> imagesTotal{0};
+    std::atomic<int> imagesDone{0};
+    std::atomic<int> imagesFailed{0};
+
+    QSemaphore downloadSlots{maxDownloads};   // 진행 중 다운로드 + 기록 대기 이미지 수 한도
+
+    // 아래는 zipMutex로 보호 (행 기록 스레드, 이미지 기록 스레드)
+    QMutex zipMutex;
+    ZipWriter *zip = nullptr;         // 생산 작업이 끝나면 nullptr → 늦게 온 이미지는 버림
+    QString error;
+    QStringList missing;              // 받지 못한 이미지 URL
+
+    void fail(const QString &message) {
+        QMutexLocker locker(&zipMutex);
+        if (error.isEmpty()) error = message;
+        cancelled = true;
+    }
+};
+
+EventExporter::EventExporter(QObject *parent)
+    : QObject(parent)
+{
+    workerPool.setMaxThreadCount(2);
+    connect(NetworkClient::instance(), &NetworkClient::hostCancelled, this, &EventExporter::onHostCancelled);
+}
+
+EventExporter::~EventExporter()
+{
+    cancel();
+    workerPool.waitForDone();
+}
+
+bool EventExporter::start(const EventSnapshot &snapshot, const EventQueryPlan &plan, const Options &options,
+                          qint64 expectedRows)
+{
+    if (current) return false;
+
+    auto job = std::make_shared<Job>();
+    job->options = options;
+    job->expectedRows = expectedRows;
+    job->cache = ImageCache::instance();   // 디스크 경로 계산만 작업 스레드에서
+    current = job;
+
+    workerPool.start([=]() {
+        produce(job, snapshot, plan);
+    });
+    return true;
+}
+
+void EventExporter::cancel()
+{
+    if (!current) return;
+    current->cancelled = true;
+
+    // 핸들러가 불리지 않으므로 슬롯은 여기서 반환
+    for (auto it = downloads.cbegin(); it != downloads.cend(); ++it) {
+        NetworkClient::instance()->cancel(it->requestId);
+        current->downloadSlots.release();
+    }
+    downloads.clear();
+}
+
+void EventExporter::produce(std::shared_ptr<Job> job, const EventSnapshot &snapshot, const EventQueryPlan &plan)
+{
+    const Options &options = job->options;
+    auto finish = [&](bool ok, const QString &message) {
+        QMetaObject::invokeMethod(this, [=]() { onFinished(job, ok, message); }, Qt::QueuedConnection);
+    };
+
+    QSaveFile output(options.path);
+    if (!output.open(QIODevice::WriteOnly)) {
+        finish(false, output.errorString());
+        return;
+    }
+
+    // 이미지 포함: 표는 임시 파일에 쓰고 마지막에 ZIP 항목으로 복사 (이미지는 받는 대로 ZIP에 바로)
+    QTemporaryFile tableFile;
+    QIODevice *table = &output;
+    ZipWriter zip(&output);
+    if (options.withImages) {
+        if (!tableFile.open()) {
+            finish(false, tableFile.errorString());
+            return;
+        }
+        table = &tableFile;
+        QMutexLocker locker(&job->zipMutex);
+        job->zip = &zip;
+    }
+
+    const bool csv = options.format == Csv;
+    if (csv) {
+        QByteArray header = "\xEF\xBB\xBFtime,camera,function,event,details,image_url";
+        if (options.withImages) header += ",image_file";
+        table->write(header + "\r\n");
+    }
+
+    // 최근 URL → ZIP 항목 (같은 이미지를 연달아 가리키는 행은 한 번만 받음)
+    //    스냅샷 URL은 대부분 이벤트마다 달라 전체 목록은 행 수만큼 커짐 → 최근 몇 개만
+    QHash<QString, QString> recentImages;
+    std::deque<QString> recentOrder;
+    const bool completed = plan.run(snapshot, rowChunk, rowChunk, [&](const QVector<quint64> &seqs) {
+        QByteArray lines;
+        for (quint64 seq : seqs) {
+            const EventRecord &record = snapshot.at(seq);
+            const QString url = record.imageUrl();
+
+            QString imageFile;
+            if (options.withImages && !url.isEmpty()) {
+                auto it = recentImages.constFind(url);
+                if (it != recentImages.constEnd()) {
+                    imageFile = *it;
+                } else {
+                    imageFile = imageEntryName(seq, url);
+                    if (!addImage(job, url, imageFile)) return false;
+                    recentImages.insert(url, imageFile);
+                    recentOrder.push_back(url);
+                    if (int(recentOrder.size()) > recentImageCount) {
+                        recentImages.remove(recentOrder.front());
+                        recentOrder.pop_front();
+                    }
+                }
+            }
+
+            if (csv) {
+                lines += csvField(record.timestampText()) + ',' + csvField(record.cameraName()) + ',' +
+                         csvField(record.functionName()) + ',' + csvField(record.eventText()) + ',' +
+                         csvField(record.details) + ',' + csvField(url);
+                if (options.withImages) lines += ',' + csvField(imageFile);
+                lines += "\r\n";
+            } else {
+                QJsonObject object{
+                    {"time", record.timestampText()},
+                    {"camera", record.cameraName()},
+                    {"function", record.functionName()},
+                    {"event", record.eventText()},
+                    {"details", record.details},
+                    {"image_url", url},
+                };
+                if (options.withImages) object.insert("image_file", imageFile);
+                lines += QJsonDocument(object).toJson(QJsonDocument::Compact) + '\n';
+            }
+        }
+
+        if (table->write(lines) != lines.size()) {
+            job->fail(table->errorString());
+            return false;
+        }
+        job->rows += seqs.size();
+        QMetaObject::invokeMethod(this, [=]() { reportProgress(job); }, Qt::QueuedConnection);
+        return !job->cancelled;
+    }, [&]() { return job->cancelled.load(); });
+
+    bool ok = completed && !job->cancelled;
+    if (ok && options.withImages) {
+        // 진행 중인 다운로드/기록이 모두 끝나면 (슬롯 전부 회수) 표와 목차를 씀
+        while (!job->downloadSlots.tryAcquire(maxDownloads, waitMs)) {
+            if (job->cancelled) {
+                ok = false;
+                break;
+            }
+        }
+        if (ok) {
+            job->downloadSlots.release(maxDownloads);
+            QMutexLocker locker(&job->zipMutex);
+            const QString tableName = csv ? "events.csv" : "events.jsonl";
+            ok = zip.addFile(tableName, &tableFile) &&
+                 (job->missing.isEmpty() || zip.addFile("missing_images.txt", job->missing.join('\n').toUtf8())) &&
+                 zip.finish();
+            if (!ok && job->error.isEmpty()) job->error = zip.errorString();
+        }
+    }
+
+    QString message;
+    {
+        QMutexLocker locker(&job->zipMutex);
+        job->zip = nullptr;
+        message = job->error;
+    }
+
+    if (ok && !output.commit()) {
+        ok = false;
+        message = output.errorString();
+    }
+    if (!ok) {
+        output.cancelWriting();
+        if (message.isEmpty()) message = "취소됨";
+        finish(false, message);
+        return;
+    }
+
+    message = QString("%1건").arg(QLocale().toString(job->rows.load()));
+    if (options.withImages) {
+        message += QString(", 이미지 %1개").arg(job->imagesDone.load());
+        if (job->imagesFailed > 0)
+            message += QString(" (받지 못한 이미지 %1개: missing_images.txt)").arg(job->imagesFailed.load());
+    }
+    finish(true, message);
+}
+
+bool EventExporter::addImage(const std::shared_ptr<Job> &job, const QString &url, const QString &name)
+{
+    ++job->imagesTotal;
+
+    // 1) 이미지 캐시 디스크 파일 → 바로 복사 (정리로 방금 지워졌으면 다운로드)
+    QFile cachedFile(job->cache->diskPath(url));
+    if (cachedFile.open(QIODevice::ReadOnly)) {
+        QMutexLocker locker(&job->zipMutex);
+        if (!job->zip->addFile(name, &cachedFile)) {
+            if (job->error.isEmpty()) job->error = job->zip->errorString();
+            job->cancelled = true;
+            return false;
+        }
+        ++job->imagesDone;
+        return true;
+    }
+
+    // 2) 다운로드 슬롯이 날 때까지 대기 (행 기록도 함께 멈춤 → 메모리 일정)
+    while (!job->downloadSlots.tryAcquire(1, waitMs)) {
+        if (job->cancelled) return false;
+    }
+    if (job->cancelled) {
+        job->downloadSlots.release();
+        return false;
+    }
+    QMetaObject::invokeMethod(this, [=]() { startDownload(job, url, name); }, Qt::QueuedConnection);
+    return true;
+}
+
+void EventExporter::startDownload(std::shared_ptr<Job> job, const QString &url, const QString &name)
+{
+    if (job != current || job->cancelled) {
+        job->downloadSlots.release();
+        return;
+    }
+
+    const quint64 key = ++nextDownload;
+    const QUrl target(url);
+    const quint64 requestId = NetworkClient::instance()->get(QNetworkRequest(target), NetworkClient::Low, this,
+                                                             [=](QNetworkReply *reply) {
+        if (downloads.remove(key) == 0) return;   // 취소됨 (슬롯은 이미 반환)
+
+        if (reply->error() != QNetworkReply::NoError) {
+            qWarning() << "[내보내기] 이미지 다운로드 실패:" << url << reply->errorString();
+            failDownload(job, url);
+            return;
+        }
+
+        // ZIP 기록은 작업 스레드 (행 기록과는 zipMutex로 번갈아)
+        const QByteArray bytes = reply->readAll();
+        workerPool.start([=]() {
+            {
+                QMutexLocker locker(&job->zipMutex);
+                if (job->zip && !job->cancelled) {
+                    if (job->zip->addFile(name, bytes)) {
+                        ++job->imagesDone;
+                    } else {
+                        if (job->error.isEmpty()) job->error = job->zip->errorString();
+                        job->cancelled = true;
+                    }
+                }
+            }
+            job->downloadSlots.release();
+            QMetaObject::invokeMethod(this, [=]() { reportProgress(job); }, Qt::QueuedConnection);
+        });
+    });
+    downloads.insert(key, {requestId, url, target.host()});
+}
+
+void EventExporter::failDownload(const std::shared_ptr<Job> &job, const QString &url)
+{
+    {
+        QMutexLocker locker(&job->zipMutex);
+        job->missing.append(url);
+    }
+    ++job->imagesFailed;
+    job->downloadSlots.release();
+    reportProgress(job);
+}
+
+void EventExporter::onHostCancelled(const QString &host)
+{
+    // 카메라 삭제로 취소된 다운로드: 핸들러가 오지 않으므로 실패 처리
+    if (!current) return;
+    for (auto it = downloads.begin(); it != downloads.end();) {
+        if (it->host == host) {
+            const QString url = it->url;
+            it = downloads.erase(it);
+            failDownload(current, url);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void EventExporter::reportProgress(const std::shared_ptr<Job> &job)
+{
+    if (job != current) return;
+    emit progress(job->rows, job->expectedRows, job->imagesDone + job->imagesFailed, job->imagesTotal);
+}
+
+void EventExporter::onFinished(const std::shared_ptr<Job> &job, bool ok, const QString &message)
+{
+    if (job != current) return;
+    current.reset();
+
+    // 실패로 끝났으면 아직 받는 중인 이미지는 필요 없음
+    for (auto it = downloads.cbegin(); it != downloads.cend(); ++it)
+        NetworkClient::instance()->cancel(it->requestId);
+    downloads.clear();
+    emit finished(ok, message);
+}
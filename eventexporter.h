@@ -0,0 +1,77 @@
+#ifndef EVENTEXPORTER_H
+#define EVENTEXPORTER_H
+
+#include "eventsnapshot.h"
+#include "eventquery.h"
+
+#include <QObject>
+#include <QHash>
+#include <QString>
+#include <QThreadPool>
+
+#include <memory>
+
+// ✅ 이력 내보내기 (감사 제출용: 현재 필터 결과 + 스냅샷 이미지)
+//    - 행은 작업 스레드에서 실행 계획을 돌리며 묶음 단위로 바로 파일에 씀 → 결과 전체를 메모리에 두지 않음
+//    - CSV(UTF-8 BOM, 엑셀 호환) 또는 JSON Lines
+//    - 이미지 포함: ZIP 1개 (events.csv|jsonl + images/...)
+//      이미지 캐시의 디스크 파일이 있으면 그대로 복사, 없으면 낮은 우선순위로 다운로드
+//      동시에 받는 이미지는 maxDownloads개까지 (받은 바이트만 잠깐 메모리에, 기록 후 다음 다운로드)
+//      받지 못한 이미지는 missing_images.txt에 URL 목록
+//    - 결과 파일은 QSaveFile: 취소/실패하면 기존 파일을 건드리지 않음
+//    한 번에 하나만 실행, 시그널은 GUI 스레드에서
+class EventExporter : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Format { Csv, JsonLines };
+
+    struct Options {
+        QString path;
+        Format format = Csv;
+        bool withImages = false;
+    };
+
+    static constexpr int maxDownloads = 8;
+
+    explicit EventExporter(QObject *parent = nullptr);
+    ~EventExporter();
+
+    // plan은 snapshot과 같은 시점에 만든 것 (EventRing::snapshot / plan)
+    // expectedRows: 진행률 표시용 예상 행 수 (모르면 -1)
+    bool start(const EventSnapshot &snapshot, const EventQueryPlan &plan, const Options &options,
+               qint64 expectedRows = -1);
+    void cancel();
+    bool isRunning() const { return current != nullptr; }
+
+signals:
+    void progress(qint64 rows, qint64 expectedRows, int imagesDone, int imagesTotal);
+    void finished(bool ok, const QString &message);
+
+private:
+    struct Job;
+
+    void produce(std::shared_ptr<Job> job, const EventSnapshot &snapshot, const EventQueryPlan &plan);
+    bool addImage(const std::shared_ptr<Job> &job, const QString &url, const QString &name);
+
+    // GUI 스레드
+    void startDownload(std::shared_ptr<Job> job, const QString &url, const QString &name);
+    void failDownload(const std::shared_ptr<Job> &job, const QString &url);
+    void onHostCancelled(const QString &host);
+    void reportProgress(const std::shared_ptr<Job> &job);
+    void onFinished(const std::shared_ptr<Job> &job, bool ok, const QString &message);
+
+    struct Download {
+        quint64 requestId;
+        QString url;
+        QString host;
+    };
+
+    std::shared_ptr<Job> current;
+    QHash<quint64, Download> downloads;   // 다운로드 번호 → 진행 중 요청 (취소 시 슬롯 반환)
+    quint64 nextDownload = 0;             // 같은 URL이 동시에 여럿 받아질 수 있어 URL이 아니라 번호로 구분
+    QThreadPool workerPool;               // 스레드 2개: 행 기록 1 + 받은 이미지 기록 1
+};
+
+#endif // EVENTEXPORTER_H
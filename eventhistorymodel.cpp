@@ -0,0 +1,251 @@
+#include "eventhistorymodel.h"
+
+#include <algorithm>
+
+namespace {
+constexpr int firstChunkRows = 256;     // 첫 화면 분량은 바로
+constexpr int chunkRows = 16384;
+}
+
+EventHistoryModel::EventHistoryModel(const EventRing &ring, QObject *parent)
+    : QAbstractTableModel(parent), ring(ring), latestGeneration(std::make_shared<std::atomic<quint64>>(0))
+{
+    workerPool.setMaxThreadCount(1);
+
+    liveTimer.setSingleShot(true);
+    liveTimer.setInterval(100);
+    connect(&liveTimer, &QTimer::timeout, this, &EventHistoryModel::applyLiveChanges);
+    connect(&ring, &EventRing::changed, this, &EventHistoryModel::onRingChanged);
+}
+
+EventHistoryModel::~EventHistoryModel()
+{
+    // 실행 중인 작업이 this로 결과를 보내기 전에 소멸되지 않도록 멈추고 대기
+    latestGeneration->store(++generation);
+    workerPool.waitForDone();
+}
+
+int EventHistoryModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) return 0;
+    return filtered ? int(rows.size()) : int(viewEnd - viewHead);
+}
+
+int EventHistoryModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+quint64 EventHistoryModel::seqAt(int row) const
+{
+    return filtered ? rows[size_t(row)] : viewEnd - 1 - quint64(row);
+}
+
+QVariant EventHistoryModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= rowCount()) return QVariant();
+
+    // 사본이라 다음 반영 전까지 링에서 밀려나도 그대로 읽힘
+    const EventRecord &record = snapshot.at(seqAt(index.row()));
+
+    if (role == ImageUrlRole) return record.imageUrl();
+    if (role == Qt::ToolTipRole) return record.details.isEmpty() ? QVariant() : QVariant(record.details);
+    if (role != Qt::DisplayRole) return QVariant();
+
+    switch (index.column()) {
+    case TimeColumn:     return record.timestampText();
+    case CameraColumn:   return record.cameraName();
+    case FunctionColumn: return record.functionName();
+    case EventColumn:    return record.eventText();
+    default:             return QVariant();
+    }
+}
+
+QVariant EventHistoryModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role != Qt::DisplayRole) return QVariant();
+    if (orientation == Qt::Vertical) return section + 1;
+
+    switch (section) {
+    case TimeColumn:     return QStringLiteral("Time");
+    case CameraColumn:   return QStringLiteral("Camera");
+    case FunctionColumn: return QStringLiteral("Function");
+    case EventColumn:    return QStringLiteral("Event");
+    default:             return QVariant();
+    }
+}
+
+void EventHistoryModel::setFilter(const EventQuery &query)
+{
+    this->query = query;
+    refresh();
+}
+
+void EventHistoryModel::refresh()
+{
+    // 이전 작업 중단 (다음 확인 지점에서 멈추고, 이미 보낸 묶음은 세대가 달라 버려짐)
+    const quint64 jobGeneration = ++generation;
+    latestGeneration->store(jobGeneration);
+
+    beginResetModel();
+    snapshot = ring.snapshot();
+    filtered = !query.isUnfiltered();
+    rows.clear();
+    viewHead = snapshot.firstSeq();
+    viewEnd = snapshot.endSeq();
+    liveFloor = viewEnd;
+    livePending = false;   // 새 사본에 이미 포함
+    liveTimer.stop();
+    endResetModel();
+
+    if (!filtered) {
+        setFiltering(false);
+        return;
+    }
+
+    // 계획(색인 조회)은 링과 같은 스레드에서, 실행은 사본으로 작업 스레드에서
+    const EventQueryPlan plan = ring.plan(query);
+    const EventSnapshot source = snapshot;
+    std::shared_ptr<std::atomic<quint64>> latest = latestGeneration;
+    setFiltering(true);
+
+    workerPool.start([=]() {
+        auto cancelled = [&]() { return latest->load() != jobGeneration; };
+        const bool finished = plan.run(source, firstChunkRows, chunkRows, [&](const QVector<quint64> &seqs) {
+            if (cancelled()) return false;
+            QMetaObject::invokeMethod(this, [=]() {
+                appendRows(jobGeneration, seqs, false);
+            }, Qt::QueuedConnection);
+            return true;
+        }, cancelled);
+
+        if (finished) {
+            QMetaObject::invokeMethod(this, [=]() {
+                appendRows(jobGeneration, {}, true);
+            }, Qt::QueuedConnection);
+        }
+    });
+}
+
+void EventHistoryModel::appendRows(quint64 rowsGeneration, const QVector<quint64> &seqs, bool done)
+{
+    if (rowsGeneration != generation) return;   // 그 사이 필터가 바뀜
+
+    // 그 사이 실시간으로 반영된 구간(liveFloor 이상)과 밀려난 항목은 제외
+    QVector<quint64> accepted;
+    accepted.reserve(seqs.size());
+    for (quint64 seq : seqs) {
+        if (seq < liveFloor && seq >= snapshot.firstSeq())
+            accepted.append(seq);
+    }
+
+    if (!accepted.isEmpty()) {
+        beginInsertRows(QModelIndex(), int(rows.size()), int(rows.size() + accepted.size()) - 1);
+        rows.insert(rows.end(), accepted.begin(), accepted.end());
+        endInsertRows();
+    }
+    if (done) setFiltering(false);
+}
+
+void EventHistoryModel::setFiltering(bool running)
+{
+    if (filtering == running) return;
+    filtering = running;
+    emit filteringChanged(running);
+}
+
+void EventHistoryModel::onRingChanged(quint64 fromSeq)
+{
+    pendingFrom = livePending ? std::min(pendingFrom, fromSeq) : fromSeq;
+    livePending = true;
+    if (!liveTimer.isActive()) liveTimer.start();
+}
+
+void EventHistoryModel::applyLiveChanges()
+{
+    if (!livePending) return;
+    livePending = false;
+    const quint64 fromSeq = pendingFrom;
+    EventSnapshot next = ring.snapshot();
+
+    // 위쪽 (최신): 다시 쓰였거나 새로 들어온 구간의 기존 행 제거
+    // 아래쪽 (오래된): 링에서 밀려난 행 제거 → 남은 행은 새 사본에서도 같은 항목
+    if (filtered) {
+        int top = 0;
+        while (top < int(rows.size()) && rows[size_t(top)] >= fromSeq) ++top;
+        if (top > 0) {
+            beginRemoveRows(QModelIndex(), 0, top - 1);
+            rows.erase(rows.begin(), rows.begin() + top);
+            endRemoveRows();
+        }
+
+        int keep = int(rows.size());
+        while (keep > 0 && rows[size_t(keep - 1)] < next.firstSeq()) --keep;
+        if (keep < int(rows.size())) {
+            beginRemoveRows(QModelIndex(), keep, int(rows.size()) - 1);
+            rows.erase(rows.begin() + keep, rows.end());
+            endRemoveRows();
+        }
+
+        liveFloor = std::min(liveFloor, fromSeq);
+        snapshot = next;
+
+        // 바뀐 구간만 다시 고름 (보통 몇 건이라 GUI 스레드에서 바로)
+        QVector<quint64> fresh;
+        ring.plan(query, fromSeq).run(snapshot, 1024, 1024, [&](const QVector<quint64> &seqs) {
+            fresh += seqs;
+            return true;
+        });
+        if (!fresh.isEmpty()) {
+            beginInsertRows(QModelIndex(), 0, int(fresh.size()) - 1);
+            rows.insert(rows.begin(), fresh.begin(), fresh.end());
+            endInsertRows();
+        }
+        return;
+    }
+
+    const quint64 keepEnd = std::max(std::min(fromSeq, viewEnd), viewHead);
+    if (keepEnd < viewEnd) {
+        beginRemoveRows(QModelIndex(), 0, int(viewEnd - keepEnd) - 1);
+        viewEnd = keepEnd;
+        endRemoveRows();
+    }
+
+    const quint64 keepHead = std::min(std::max(next.firstSeq(), viewHead), viewEnd);
+    if (keepHead > viewHead) {
+        const int count = int(viewEnd - viewHead);
+        beginRemoveRows(QModelIndex(), count - int(keepHead - viewHead), count - 1);
+        viewHead = keepHead;
+        endRemoveRows();
+    }
+
+    snapshot = next;
+    if (viewHead < snapshot.firstSeq())   // 보이던 행이 모두 밀려남
+        viewHead = viewEnd = snapshot.firstSeq();
+
+    if (snapshot.endSeq() > viewEnd) {
+        beginInsertRows(QModelIndex(), 0, int(snapshot.endSeq() - viewEnd) - 1);
+        viewEnd = snapshot.endSeq();
+        endInsertRows();
+    }
+}
+
+QString EventHistoryModel::imageUrl(int row) const
+{
+    if (row < 0 || row >= rowCount()) return QString();
+    return snapshot.at(seqAt(row)).imageUrl();
+}
+
+int EventHistoryModel::rowBefore(qint64 ms) const
+{
+    int low = 0;
+    int high = rowCount();
+    while (low < high) {
+        const int mid = low + (high - low) / 2;
+        if (snapshot.timeAt(seqAt(mid)) >= ms)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low < rowCount() ? low : -1;
+}
@@ -0,0 +1,83 @@
+#ifndef EVENTHISTORYMODEL_H
+#define EVENTHISTORYMODEL_H
+
+#include "eventring.h"
+
+#include <QAbstractTableModel>
+#include <QThreadPool>
+#include <QTimer>
+#include <QVector>
+
+#include <atomic>
+#include <deque>
+#include <memory>
+
+// ✅ 전체 로그 보기 테이블 모델 (최신 항목이 0번 행, 모든 탭이 공유)
+//    EventRing 사본(EventSnapshot)을 순번으로 읽음, 문자열은 보이는 셀만 조립
+//    - 필터 없음: 행 → 순번 계산만 (색인 없음, 즉시)
+//    - 필터 있음: 색인으로 만든 실행 계획을 작업 스레드에서 실행, 결과는 묶음 단위로 행 추가
+//      새 필터를 걸면 세대 번호가 바뀌어 진행 중인 작업은 다음 확인 지점에서 멈추고 결과는 버려짐
+//    - 열려 있는 동안 링이 바뀌면 (changed) 모아서 100ms마다 바뀐 부분만 반영
+//      위쪽: 다시 쓰인 순번 이후 행을 빼고 새 사본에서 그 구간만 다시 골라 넣음
+//      아래쪽: 링에서 밀려난 행만 뺌 → 전체 다시 필터링 없음
+//    범위는 메모리의 링까지 (최근 30일, 최대 20만 건) → 그보다 오래된 이력은 EventStore에만 있음
+class EventHistoryModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Columns { TimeColumn, CameraColumn, FunctionColumn, EventColumn, ColumnCount };
+    enum Roles { ImageUrlRole = Qt::UserRole + 1 };
+
+    // ring은 모델보다 오래 살아 있어야 함
+    explicit EventHistoryModel(const EventRing &ring, QObject *parent = nullptr);
+    ~EventHistoryModel();
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    void setFilter(const EventQuery &query);
+    void refresh();
+
+    bool isFiltering() const { return filtering; }
+    QString imageUrl(int row) const;
+
+    // 시각이 ms 미만인 첫 행 (행은 최신 순 = 시각 내림차순이라 이진 탐색), 없으면 -1
+    int rowBefore(qint64 ms) const;
+
+signals:
+    void filteringChanged(bool running);   // 작업 스레드 필터링 시작 / 끝 (행 수는 rowCount)
+
+private:
+    quint64 seqAt(int row) const;
+    void appendRows(quint64 rowsGeneration, const QVector<quint64> &seqs, bool done);
+    void setFiltering(bool running);
+    void onRingChanged(quint64 fromSeq);
+    void applyLiveChanges();
+
+    const EventRing &ring;
+    EventQuery query;
+    EventSnapshot snapshot;
+
+    bool filtered = false;
+    bool filtering = false;
+
+    // 필터 없음: 보이는 순번 구간 [viewHead, viewEnd), 행 0 = viewEnd - 1
+    quint64 viewHead = 0;
+    quint64 viewEnd = 0;
+    // 필터 있음: 행 → 순번 (최신 순, 실시간 추가는 앞에, 작업 스레드 결과는 뒤에)
+    std::deque<quint64> rows;
+
+    quint64 liveFloor = 0;        // 이 순번 이상은 실시간 반영이 담당 (진행 중 작업 결과에서 제외)
+    quint64 pendingFrom = 0;      // 모아 둔 변경의 가장 작은 fromSeq
+    bool livePending = false;
+    QTimer liveTimer;
+
+    QThreadPool workerPool;       // 스레드 1개 (이전 작업은 세대 확인으로 곧 끝남)
+    std::shared_ptr<std::atomic<quint64>> latestGeneration;   // 작업 스레드와 공유
+    quint64 generation = 0;
+};
+
+#endif // EVENTHISTORYMODEL_H
@@ -0,0 +1,248 @@
+#include "eventingestworker.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QElapsedTimer>
+#include <QUrl>
+#include <QDebug>
+
+EventIngestWorker::EventIngestWorker(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void EventIngestWorker::syncCameras(const QVector<CameraInfo> &cameras)
+{
+    QMap<QString, CameraInfo> next;
+    for (const CameraInfo &camera : cameras)
+        next.insert(camera.ip, camera);
+
+    // 🗑 삭제된 카메라의 소켓 정리
+    for (auto it = socketMap.begin(); it != socketMap.end();) {
+        if (!next.contains(it.key())) {
+            qDebug() << "[WebSocket 제거]" << it.key();
+            QWebSocket *sock = it.value();
+            it = socketMap.erase(it);
+            sock->disconnect(this);
+            sock->close();
+            sock->deleteLater();
+        } else {
+            ++it;
+        }
+    }
+    cameraMap = next;
+
+    for (const CameraInfo &camera : cameras) {
+        // 이미 연결(시도) 중인 경우 생략
+        if (QWebSocket *existing = socketMap.value(camera.ip)) {
+            if (existing->state() == QAbstractSocket::ConnectedState ||
+                existing->state() == QAbstractSocket::ConnectingState) {
+                continue;
+            }
+            socketMap.remove(camera.ip);
+            existing->disconnect(this);
+            existing->deleteLater();
+        }
+        openSocket(camera);
+    }
+}
+
+void EventIngestWorker::openSocket(const CameraInfo &camera)
+{
+    const QString ip = camera.ip;
+    QWebSocket *socket = new QWebSocket(QString(), QWebSocketProtocol::VersionLatest, this);
+    socketMap[ip] = socket;
+
+    connect(socket, &QWebSocket::sslErrors, this, [socket](const QList<QSslError> &) {
+        socket->ignoreSslErrors();
+    });
+
+    connect(socket, &QWebSocket::connected, this, [=]() {
+        qDebug() << "[WebSocket 연결 성공]" << ip;
+        emit cameraConnected(ip);
+    });
+
+    connect(socket, &QWebSocket::disconnected, this, [=]() {
+        qDebug() << "[WebSocket 연결 해제]" << ip;
+        if (socketMap.value(ip) == socket)
+            socketMap.remove(ip);
+        socket->deleteLater();
+        emit cameraDisconnected(ip);
+    });
+
+    connect(socket, &QWebSocket::errorOccurred, this, [=](QAbstractSocket::SocketError error) {
+        qWarning() << "[WebSocket 에러]" << ip << error;
+        emit cameraErrorOccurred(ip, error);
+    });
+
+    connect(socket, &QWebSocket::textMessageReceived, this, [=](const QString &message) {
+        CameraEvent event;
+        if (parseMessage(ip, message, event))
+            emit eventReady(event);
+    });
+
+    QString wsUrl = QString("wss://%1:8443/ws").arg(ip);
+    socket->open(QUrl(wsUrl));  // ✅ 연결 시도
+}
+
+void EventIngestWorker::removeCamera(const QString &ip)
+{
+    cameraMap.remove(ip);
+    if (QWebSocket *sock = socketMap.take(ip)) {
+        sock->disconnect(this);
+        sock->close();
+        sock->deleteLater();
+        qDebug() << "[WebSocket 제거]" << ip;
+    }
+}
+
+void EventIngestWorker::sendMessage(const QString &ip, const QString &message)
+{
+    QWebSocket *socket = socketMap.value(ip);
+    if (!socket || socket->state() != QAbstractSocket::ConnectedState) {
+        qWarning() << "[WebSocket] 비연결 상태, 전송 생략 →" << ip;
+        return;
+    }
+    socket->sendTextMessage(message);
+}
+
+void EventIngestWorker::shutdown()
+{
+    for (QWebSocket *sock : std::as_const(socketMap)) {
+        sock->disconnect(this);
+        sock->close();
+        delete sock;
+    }
+    socketMap.clear();
+}
+
+bool EventIngestWorker::parseMessage(const QString &ip, const QString &message, CameraEvent &out)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    qDebug() << "[WebSocket 수신 메시지]" << message;
+
+    QJsonDocument doc = QJsonDocument::fromJson(message.toUtf8());
+    if (!doc.isObject()) {
+        qWarning() << "[WebSocket 메시지] JSON 파싱 실패";
+        return false;
+    }
+
+    auto camIt = cameraMap.constFind(ip);
+    if (camIt == cameraMap.constEnd()) {
+        qWarning() << "[WebSocket] CameraInfo 찾기 실패 for IP:" << ip;
+        return false;
+    }
+
+    QJsonObject obj = doc.object();
+    QString type = obj["type"].toString();
+    QJsonObject data = obj["data"].toObject();
+
+    out.typeName = type;
+    out.cameraIp = ip;
+    out.cameraName = camIt->name;
+
+    if (type == "new_detection") {
+        int person = data["person_count"].toInt();
+        int helmet = data["helmet_count"].toInt();
+        int vest = data["safety_vest_count"].toInt();
+        double conf = data["avg_confidence"].toDouble();
+
+        out.type = CameraEvent::Type::Detection;
+        out.function = "PPE";
+        out.imagePath = data["image_path"].toString();
+        out.timestamp = data["timestamp"].toString();
+        out.details = QString("👷 %1명 | ⛑️ %2명 | 🦺 %3명 | 신뢰도: %4")
+                          .arg(person).arg(helmet).arg(vest).arg(conf, 0, 'f', 2);
+
+        if (helmet < person && vest >= person)
+            out.event = "⛑️ 헬멧 미착용 감지";
+        else if (vest < person && helmet >= person)
+            out.event = "🦺 조끼 미착용 감지";
+        else
+            out.event = "⛑️ 🦺 PPE 미착용 감지";
+
+        out.ppeViolation = out.event.contains("미착용");
+    }
+
+    else if (type == "new_trespass") {
+        out.type = CameraEvent::Type::Trespass;
+        out.function = "Trespass";
+        out.timestamp = data["timestamp"].toString();
+        out.count = data["count"].toInt();
+        out.imagePath = data["image_path"].toString();
+
+        if (out.count <= 0) return false;
+        out.event = QString("🚷 무단 침입 감지 (%1명)").arg(out.count);
+        out.details = QString("감지 시각: %1 | 침입자 수: %2").arg(out.timestamp).arg(out.count);
+    }
+
+    else if (type == "new_blur") {
+        out.type = CameraEvent::Type::Blur;
+        out.function = "Blur";
+        out.timestamp = data["timestamp"].toString();
+
+        QString key = out.cameraName + "_" + out.timestamp;
+        if (recentBlurLogKeys.contains(key)) {
+            qDebug() << "[BLUR 중복 무시]" << key;
+            return false;
+        }
+        recentBlurLogKeys.insert(key);
+
+        out.count = data["count"].toInt();
+        out.event = QString("🔍 %1명 감지").arg(out.count);
+    }
+
+    else if (type == "new_fall") {
+        out.type = CameraEvent::Type::Fall;
+        out.function = "Fall";
+        out.timestamp = data["timestamp"].toString();
+        out.count = data["count"].toInt();
+        out.imagePath = data["image_path"].toString();
+
+        if (out.count <= 0) return false;
+        out.event = "🚨 낙상 감지";
+        out.details = QString("낙상 감지 시각: %1").arg(out.timestamp);
+    }
+
+    else if (type == "anomaly_status") {
+        out.type = CameraEvent::Type::AnomalyStatus;
+        out.function = "Sound";
+        out.status = data["status"].toString();
+        out.timestamp = data["timestamp"].toString();
+        qDebug() << "[이상소음 상태]" << out.status << "at" << out.timestamp;
+    }
+
+    else if (type == "stm_status_update") {
+        out.type = CameraEvent::Type::StmStatus;
+        out.details = QString("🌡️ 온도: %1°C | 💡 밝기: %2 | 🔔 버저: %3 | 💡 LED: %4")
+                          .arg(data["temperature"].toDouble(), 0, 'f', 2)
+                          .arg(data["light"].toInt())
+                          .arg(data["buzzer_on"].toBool() ? "ON" : "OFF")
+                          .arg(data["led_on"].toBool() ? "ON" : "OFF");
+    }
+
+    else if (type == "mode_change_ack") {
+        out.type = CameraEvent::Type::ModeChangeAck;
+        out.status = obj["status"].toString();
+        out.mode = obj["mode"].toString();
+        out.message = obj["message"].toString();
+    }
+
+    else if (type == "log") {
+        out.type = CameraEvent::Type::Log;
+        out.event = data["event"].toString();
+        out.details = data["details"].toString();
+        out.function = data["function"].toString();  // 예: "Blur", "PPE" 등
+        out.imagePath = data["image_path"].toString();
+    }
+
+    else {
+        qWarning() << "[WebSocket] 알 수 없는 타입 수신:" << type;
+        return false;
+    }
+
+    out.parseNsecs = timer.nsecsElapsed();
+    return true;
+}
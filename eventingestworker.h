@@ -0,0 +1,46 @@
+#ifndef EVENTINGESTWORKER_H
+#define EVENTINGESTWORKER_H
+
+#include "camerainfo.h"
+#include "cameraevent.h"
+
+#include <QObject>
+#include <QMap>
+#include <QSet>
+#include <QVector>
+#include <QtWebSockets/QWebSocket>
+
+// ✅ 전용 수신 스레드에서 동작하는 WebSocket 워커
+//    - 카메라별 QWebSocket 소유
+//    - JSON 파싱/검증 후 CameraEvent로 변환해서 UI 스레드에 전달
+class EventIngestWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit EventIngestWorker(QObject *parent = nullptr);
+
+public slots:
+    void syncCameras(const QVector<CameraInfo> &cameras);  // 등록/삭제 반영 후 연결 시도
+    void removeCamera(const QString &ip);
+    void sendMessage(const QString &ip, const QString &message);
+    void shutdown();
+
+signals:
+    void eventReady(const CameraEvent &event);
+    void cameraConnected(const QString &ip);
+    void cameraDisconnected(const QString &ip);
+    void cameraErrorOccurred(const QString &ip, QAbstractSocket::SocketError error);
+
+private:
+    void openSocket(const CameraInfo &camera);
+    bool parseMessage(const QString &ip, const QString &message, CameraEvent &out);
+
+    QMap<QString, QWebSocket*> socketMap;    // IP 주소 → QWebSocket
+    QMap<QString, CameraInfo> cameraMap;     // IP 주소 → CameraInfo
+
+    // ✅ Blur 중복 방지용 키 저장
+    QSet<QString> recentBlurLogKeys;
+};
+
+#endif // EVENTINGESTWORKER_H
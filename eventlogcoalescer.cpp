@@ -0,0 +1,41 @@
+#include "eventlogcoalescer.h"
+
+#include <QDebug>
+
+EventLogCoalescer::EventLogCoalescer(int maxPending, int fps, QObject *parent)
+    : QObject(parent), maxPending(maxPending)
+{
+    flushTimer.setSingleShot(true);
+    flushTimer.setInterval(1000 / qMax(1, fps));
+    connect(&flushTimer, &QTimer::timeout, this, &EventLogCoalescer::flushNow);
+}
+
+void EventLogCoalescer::enqueue(const LogEntry &entry)
+{
+    pending.append(entry);
+
+    // 한 틱 안에 표시 한도를 넘게 쌓이면 가장 오래된 것부터 버림
+    if (pending.size() > maxPending) {
+        int overflow = pending.size() - maxPending;
+        pending.remove(0, overflow);
+        droppedCount += overflow;
+    }
+
+    if (!flushTimer.isActive())
+        flushTimer.start();
+}
+
+void EventLogCoalescer::flushNow()
+{
+    flushTimer.stop();
+    if (pending.isEmpty()) return;
+
+    if (droppedCount > 0) {
+        qDebug() << "[로그 배치] 표시 한도 초과로 생략된 항목:" << droppedCount;
+        droppedCount = 0;
+    }
+
+    QVector<LogEntry> batch;
+    batch.swap(pending);
+    emit batchReady(batch);
+}
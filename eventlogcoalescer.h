@@ -0,0 +1,33 @@
+#ifndef EVENTLOGCOALESCER_H
+#define EVENTLOGCOALESCER_H
+
+#include "logentry.h"
+
+#include <QObject>
+#include <QTimer>
+#include <QVector>
+
+// ✅ 실시간 로그 배치 수집기
+//    이벤트가 몰려도 UI 틱(기본 30Hz)당 한 번만 패널에 반영
+class EventLogCoalescer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit EventLogCoalescer(int maxPending, int fps = 30, QObject *parent = nullptr);
+
+    void enqueue(const LogEntry &entry);
+    void flushNow();
+
+signals:
+    // 오래된 순 → 최신 순
+    void batchReady(const QVector<LogEntry> &batch);
+
+private:
+    QVector<LogEntry> pending;
+    QTimer flushTimer;
+    int maxPending;      // 패널 최대 표시 개수 이상은 어차피 밀려나므로 버림
+    int droppedCount = 0;
+};
+
+#endif // EVENTLOGCOALESCER_H
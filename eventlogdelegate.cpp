@@ -0,0 +1,115 @@
+#include "eventlogdelegate.h"
+#include "eventlogmodel.h"
+
+#include <QPainter>
+#include <QMouseEvent>
+#include <QPixmap>
+
+namespace {
+constexpr int kTextBlockHeight = 80;   // 카메라 / 이벤트 / 시간 3줄
+constexpr int kThumbBlockHeight = 130; // 160x120 썸네일 + 여백
+}
+
+EventLogDelegate::EventLogDelegate(QObject *parent)
+    : QStyledItemDelegate(parent)
+{
+}
+
+QRect EventLogDelegate::thumbnailRect(const QRect &itemRect)
+{
+    QSize size = EventLogModel::thumbnailSize();
+    int x = itemRect.left() + (itemRect.width() - size.width()) / 2;
+    int y = itemRect.top() + kTextBlockHeight + (kThumbBlockHeight - size.height()) / 2;
+    return QRect(QPoint(x, y), size);
+}
+
+QSize EventLogDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    bool hasImage = !index.data(EventLogModel::ImageUrlRole).toString().isEmpty();
+    return QSize(option.rect.width(), kTextBlockHeight + (hasImage ? kThumbBlockHeight : 0));
+}
+
+void EventLogDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
+                             const QModelIndex &index) const
+{
+    const QRect r = option.rect;
+
+    painter->save();
+    painter->fillRect(r, QColor("#1e1e1e"));
+
+    QFont cameraFont = option.font;
+    cameraFont.setPixelSize(12);
+    cameraFont.setBold(true);
+    QFont eventFont = option.font;
+    eventFont.setPixelSize(12);
+    QFont timeFont = option.font;
+    timeFont.setPixelSize(11);
+
+    const int textLeft = r.left() + 2;
+    const int textWidth = r.width() - 4;
+
+    // 🔹 상단 구분선 + 카메라
+    painter->setPen(QColor("#333"));
+    painter->drawLine(r.left(), r.top(), r.right(), r.top());
+
+    painter->setFont(cameraFont);
+    painter->setPen(Qt::white);
+    QString camera = "📷 " + index.data(EventLogModel::CameraRole).toString();
+    painter->drawText(QRect(textLeft, r.top() + 4, textWidth, 24), Qt::AlignLeft | Qt::AlignVCenter,
+                      painter->fontMetrics().elidedText(camera, Qt::ElideRight, textWidth));
+
+    // 🔹 이벤트
+    painter->setFont(eventFont);
+    painter->setPen(QColor("orange"));
+    QString event = index.data(EventLogModel::EventRole).toString();
+    painter->drawText(QRect(textLeft, r.top() + 28, textWidth, 24), Qt::AlignLeft | Qt::AlignVCenter,
+                      painter->fontMetrics().elidedText(event, Qt::ElideRight, textWidth));
+
+    // 🔹 시간 + 하단 구분선
+    painter->setFont(timeFont);
+    painter->setPen(Qt::gray);
+    painter->drawText(QRect(textLeft, r.top() + 52, textWidth, 24), Qt::AlignLeft | Qt::AlignVCenter,
+                      index.data(EventLogModel::TimeRole).toString());
+
+    painter->setPen(QColor("#333"));
+    painter->drawLine(r.left(), r.top() + kTextBlockHeight - 1, r.right(), r.top() + kTextBlockHeight - 1);
+
+    // 🔹 썸네일 (요청은 ThumbnailPrefetcher가 뷰포트 기준으로 관리)
+    if (!index.data(EventLogModel::ImageUrlRole).toString().isEmpty()) {
+        QRect thumbRect = thumbnailRect(r);
+        painter->fillRect(thumbRect, QColor("#333"));
+
+        int state = index.data(EventLogModel::ThumbnailStateRole).toInt();
+        if (state == EventLogModel::ThumbnailReady) {
+            QPixmap pix = index.data(EventLogModel::ThumbnailRole).value<QPixmap>();
+            QRect target(QPoint(0, 0), pix.size());
+            target.moveCenter(thumbRect.center());
+            painter->drawPixmap(target, pix);
+        } else if (state == EventLogModel::ThumbnailFailed) {
+            painter->setFont(eventFont);
+            painter->setPen(Qt::white);
+            painter->drawText(thumbRect, Qt::AlignCenter, "❌ 이미지 없음");
+        }
+
+        painter->setPen(QColor("#555"));
+        painter->drawRect(thumbRect.adjusted(0, 0, -1, -1));
+    }
+
+    painter->restore();
+}
+
+bool EventLogDelegate::editorEvent(QEvent *event, QAbstractItemModel *model,
+                                   const QStyleOptionViewItem &option, const QModelIndex &index)
+{
+    if (event->type() == QEvent::MouseButtonRelease) {
+        QMouseEvent *mouseEvent = static_cast<QMouseEvent *>(event);
+        if (mouseEvent->button() == Qt::LeftButton &&
+            thumbnailRect(option.rect).contains(mouseEvent->position().toPoint()) &&
+            index.data(EventLogModel::ThumbnailStateRole).toInt() == EventLogModel::ThumbnailReady) {
+            // ✅ 클릭 시 팝업 띄우기
+            emit thumbnailClicked(index.data(EventLogModel::ImageUrlRole).toString());
+            return true;
+        }
+    }
+    return QStyledItemDelegate::editorEvent(event, model, option, index);
+}
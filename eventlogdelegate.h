@@ -0,0 +1,29 @@
+#ifndef EVENTLOGDELEGATE_H
+#define EVENTLOGDELEGATE_H
+
+#include <QStyledItemDelegate>
+
+// ✅ 실시간 로그 한 줄을 직접 그리는 델리게이트 (카메라 / 이벤트 / 시간 + 썸네일)
+class EventLogDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    explicit EventLogDelegate(QObject *parent = nullptr);
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option,
+               const QModelIndex &index) const override;
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+
+signals:
+    void thumbnailClicked(const QString &imageUrl);
+
+protected:
+    bool editorEvent(QEvent *event, QAbstractItemModel *model,
+                     const QStyleOptionViewItem &option, const QModelIndex &index) override;
+
+private:
+    static QRect thumbnailRect(const QRect &itemRect);
+};
+
+#endif // EVENTLOGDELEGATE_H
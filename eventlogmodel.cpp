@@ -0,0 +1,148 @@
+#include "eventlogmodel.h"
+#include "imagecache.h"
+
+EventLogModel::EventLogModel(int capacity, QObject *parent)
+    : QAbstractListModel(parent), capacity(capacity)
+{
+}
+
+int EventLogModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : static_cast<int>(rows.size());
+}
+
+QVariant EventLogModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= static_cast<int>(rows.size()))
+        return QVariant();
+
+    const Row &row = rows[index.row()];
+    switch (role) {
+    case Qt::DisplayRole:
+        return row.entry.event;
+    case CameraRole:
+        return row.entry.cameraName;
+    case EventRole:
+        return row.entry.event;
+    case TimeRole:
+        return row.entry.timestamp;
+    case ImageUrlRole:
+        return row.entry.imageUrl;
+    case ThumbnailRole: {
+        QPixmap pix = ImageCache::instance()->cached(row.entry.imageUrl, thumbnailSize());
+        return pix.isNull() ? QVariant() : QVariant(pix);
+    }
+    case ThumbnailStateRole:
+        return effectiveState(row);
+    default:
+        return QVariant();
+    }
+}
+
+EventLogModel::ThumbnailState EventLogModel::effectiveState(const Row &row) const
+{
+    // 캐시에서 밀려난 썸네일은 다시 요청 대상
+    if (row.thumbState == ThumbnailReady &&
+        ImageCache::instance()->cached(row.entry.imageUrl, thumbnailSize()).isNull())
+        return NoThumbnail;
+    return row.thumbState;
+}
+
+int EventLogModel::rowForId(quint64 id) const
+{
+    if (rows.empty() || id >= nextId) return -1;
+    quint64 row = (nextId - 1) - id;
+    return row < rows.size() ? static_cast<int>(row) : -1;
+}
+
+void EventLogModel::prependBatch(const QVector<LogEntry> &batch)
+{
+    if (batch.isEmpty()) return;
+
+    // 한도를 넘는 부분은 애초에 넣지 않음
+    int count = qMin(static_cast<int>(batch.size()), capacity);
+    int first = batch.size() - count;
+
+    beginInsertRows(QModelIndex(), 0, count - 1);
+    for (int i = first; i < batch.size(); ++i)
+        rows.push_front({nextId++, batch[i], NoThumbnail, 0});
+    endInsertRows();
+
+    int overflow = static_cast<int>(rows.size()) - capacity;
+    if (overflow > 0) {
+        int firstRemoved = static_cast<int>(rows.size()) - overflow;
+        beginRemoveRows(QModelIndex(), firstRemoved, static_cast<int>(rows.size()) - 1);
+        for (int i = 0; i < overflow; ++i) {
+            cancelThumbnail(rows.back());   // 밀려나는 항목의 다운로드/디코딩 중단
+            rows.pop_back();
+        }
+        endRemoveRows();
+    }
+}
+
+void EventLogModel::setVisibleRange(int first, int last, int margin)
+{
+    const int count = static_cast<int>(rows.size());
+    if (count == 0) return;
+
+    // 빈 범위: 뷰가 숨겨짐 → 진행 중 요청 모두 취소
+    if (last < first) {
+        for (Row &row : rows)
+            cancelThumbnail(row);
+        return;
+    }
+
+    first = qBound(0, first, count - 1);
+    last = qBound(first, last, count - 1);
+    const int keepFirst = qMax(0, first - margin);
+    const int keepLast = qMin(count - 1, last + margin);
+
+    // 범위를 벗어난 행: 요청 취소 (다시 들어오면 재요청)
+    for (int i = 0; i < count; ++i) {
+        if (i >= keepFirst && i <= keepLast) {
+            i = keepLast;
+            continue;
+        }
+        if (rows[i].ticket) cancelThumbnail(rows[i]);
+    }
+
+    for (int i = first; i <= last; ++i)
+        requestThumbnail(i, NetworkClient::High);
+    for (int i = keepFirst; i < first; ++i)
+        requestThumbnail(i, NetworkClient::Low);
+    for (int i = last + 1; i <= keepLast; ++i)
+        requestThumbnail(i, NetworkClient::Low);
+}
+
+void EventLogModel::cancelThumbnail(Row &row)
+{
+    if (!row.ticket) return;
+    ImageCache::instance()->cancel(row.ticket);
+    row.ticket = 0;
+    if (row.thumbState == ThumbnailLoading)
+        row.thumbState = NoThumbnail;
+}
+
+void EventLogModel::requestThumbnail(int rowIndex, NetworkClient::Priority priority)
+{
+    if (rowIndex < 0 || rowIndex >= static_cast<int>(rows.size())) return;
+
+    Row &row = rows[rowIndex];
+    if (row.entry.imageUrl.isEmpty()) return;
+    if (effectiveState(row) != NoThumbnail) return;
+
+    const quint64 id = row.id;
+    row.thumbState = ThumbnailLoading;
+    row.ticket = ImageCache::instance()->request(row.entry.imageUrl, thumbnailSize(), this,
+                                                 [=](const QPixmap &pix) {
+        int current = rowForId(id);
+        if (current < 0) return;   // 이미 밀려난 항목
+
+        Row &target = rows[current];
+        target.ticket = 0;
+        target.thumbState = pix.isNull() ? ThumbnailFailed : ThumbnailReady;
+
+        QModelIndex idx = index(current);
+        emit dataChanged(idx, idx, {ThumbnailRole, ThumbnailStateRole});
+    }, priority);
+}
@@ -0,0 +1,67 @@
+#ifndef EVENTLOGMODEL_H
+#define EVENTLOGMODEL_H
+
+#include "logentry.h"
+#include "networkclient.h"
+
+#include <QAbstractListModel>
+#include <QPixmap>
+#include <QVector>
+
+#include <deque>
+
+// ✅ 실시간 이벤트 로그 모델 (최신 항목이 0번 행)
+//    위젯 대신 데이터만 보관하고, 썸네일은 뷰포트(+여유분) 안의 행만 요청
+class EventLogModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    enum Roles {
+        CameraRole = Qt::UserRole + 1,
+        EventRole,
+        TimeRole,
+        ImageUrlRole,
+        ThumbnailRole,
+        ThumbnailStateRole
+    };
+
+    enum ThumbnailState {
+        NoThumbnail,        // 아직 요청 전 (또는 이미지 캐시에서 밀려남)
+        ThumbnailLoading,
+        ThumbnailReady,
+        ThumbnailFailed
+    };
+
+    explicit EventLogModel(int capacity, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    void prependBatch(const QVector<LogEntry> &batch);   // 오래된 순 → 최신 순
+
+    // 보이는 행 [first, last]는 우선 요청, 앞뒤 margin 행은 낮은 우선순위로 미리 요청
+    // 범위를 벗어난 행의 진행 중 요청은 취소 (last < first면 전부 취소)
+    void setVisibleRange(int first, int last, int margin);
+
+    static QSize thumbnailSize() { return QSize(160, 120); }
+
+private:
+    struct Row {
+        quint64 id;
+        LogEntry entry;
+        ThumbnailState thumbState;
+        quint64 ticket;     // 진행 중 이미지 캐시 요청 (없으면 0)
+    };
+
+    int rowForId(quint64 id) const;
+    ThumbnailState effectiveState(const Row &row) const;
+    void requestThumbnail(int row, NetworkClient::Priority priority);
+    void cancelThumbnail(Row &row);
+
+    std::deque<Row> rows;
+    quint64 nextId = 0;
+    int capacity;
+};
+
+#endif // EVENTLOGMODEL_H
@@ -0,0 +1,90 @@
+#include "eventquery.h"
+
+#include <algorithm>
+
+bool EventQueryPlan::matches(const EventRecord &record) const
+{
+    if (camera != 0 && record.camera != camera) return false;
+    if (!functions.isEmpty() && !functions.contains(record.function)) return false;
+    QVector<quint32> detailWords;   // 문구/카메라/기능으로 안 걸릴 때만 한 번 계산
+    bool detailsRead = false;
+    for (const QSet<quint32> &ids : words) {
+        if (ids.contains(record.event) || ids.contains(record.camera) || ids.contains(record.function))
+            continue;
+        if (!detailsRead) {
+            detailWords = EventTextIndex::detailWordIds(record.details, EventStrings::find);
+            detailsRead = true;
+        }
+        if (std::none_of(detailWords.begin(), detailWords.end(), [&](quint32 word) { return ids.contains(word); }))
+            return false;
+    }
+    return true;
+}
+
+bool EventQueryPlan::run(const EventSnapshot &snapshot, int firstChunk, int chunk, const Sink &sink,
+                         const CancelCheck &cancelled) const
+{
+    if (empty) return true;
+
+    QVector<quint64> batch;
+    int limit = firstChunk;
+    batch.reserve(limit);
+    auto flush = [&]() {
+        if (batch.isEmpty()) return true;
+        if (!sink(batch)) return false;
+        batch.clear();
+        limit = chunk;
+        return true;
+    };
+
+    constexpr int cancelCheckInterval = 4096;
+    int sinceCheck = 0;
+    auto keepGoing = [&]() {
+        if (++sinceCheck < cancelCheckInterval) return true;
+        sinceCheck = 0;
+        return !(cancelled && cancelled());
+    };
+
+    if (scanAll) {
+        for (quint64 seq = hi; seq-- > lo;) {
+            batch.append(seq);
+            if (batch.size() >= limit && !flush()) return false;
+            if (!keepGoing()) return false;
+        }
+        return flush();
+    }
+
+    // 목록들을 최신 순으로 합침 (한 항목이 여러 목록에 있을 수 있음 → 직전 값과 같으면 건너뜀)
+    struct Cursor {
+        const quint64 *begin;
+        const quint64 *end;
+    };
+    std::vector<Cursor> cursors;
+    for (const std::vector<quint64> &list : candidates) {
+        if (!list.empty())
+            cursors.push_back({list.data(), list.data() + list.size()});
+    }
+
+    quint64 previous = 0;
+    bool hasPrevious = false;
+    while (true) {
+        Cursor *latest = nullptr;
+        for (Cursor &cursor : cursors) {
+            if (cursor.begin != cursor.end && (!latest || *(cursor.end - 1) > *(latest->end - 1)))
+                latest = &cursor;
+        }
+        if (!latest) break;
+
+        const quint64 seq = *--latest->end;
+        if (hasPrevious && previous == seq) continue;
+        previous = seq;
+        hasPrevious = true;
+
+        if (matches(snapshot.at(seq))) {
+            batch.append(seq);
+            if (batch.size() >= limit && !flush()) return false;
+        }
+        if (!keepGoing()) return false;
+    }
+    return flush();
+}
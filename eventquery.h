@@ -0,0 +1,56 @@
+#ifndef EVENTQUERY_H
+#define EVENTQUERY_H
+
+#include "eventsnapshot.h"
+#include "eventtextindex.h"
+
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+#include <functional>
+#include <vector>
+
+// 조합 조건 (빈 값 = 제한 없음), 예: 카메라 X + {Fall, Trespass} + 최근 2시간 + "헬멧"
+struct EventQuery {
+    quint32 camera = 0;              // EventStrings ID (0 = 전체)
+    QVector<quint32> functions;      // 허용할 기능 ID (비어 있으면 전체)
+    qint64 fromMs = 0;               // 이상 (0 = 처음부터)
+    qint64 toMs = 0;                 // 미만 (0 = 끝까지)
+    QString text;                    // 검색어 (단어마다 이벤트 문구/카메라/기능/부가 정보 중 하나에 포함돼야 함)
+
+    bool isUnfiltered() const {
+        return camera == 0 && functions.isEmpty() && fromMs == 0 && toMs == 0 && EventTextIndex::words(text).isEmpty();
+    }
+};
+
+// ✅ 조건 실행 계획
+//    EventRing::plan이 GUI 스레드에서 색인으로 만듦: 시각 → 순번 구간, 가장 짧은 후보 목록만 복사
+//    run은 같은 시점의 EventSnapshot으로 어느 스레드에서나 실행 (후보를 최신 순으로 합치며 나머지 조건 확인)
+class EventQueryPlan
+{
+public:
+    using Sink = std::function<bool(const QVector<quint64> &seqs)>;   // false 반환 → 중단
+    using CancelCheck = std::function<bool()>;
+
+    // 결과 순번을 최신 순으로 묶어서 sink에 넘김 (첫 묶음은 firstChunk개: 첫 화면을 빨리 채움)
+    // 끝까지 실행했으면 true, 중단됐으면 false
+    bool run(const EventSnapshot &snapshot, int firstChunk, int chunk, const Sink &sink,
+             const CancelCheck &cancelled = CancelCheck()) const;
+
+private:
+    friend class EventRing;
+
+    bool matches(const EventRecord &record) const;
+
+    bool empty = false;                           // 조건상 결과 없음 (없는 카메라, 일치하는 문자열 없음 등)
+    bool scanAll = false;                         // 시각 조건만 있음 → 구간 전체
+    quint64 lo = 0;                               // 순번 구간 [lo, hi)
+    quint64 hi = 0;
+    std::vector<std::vector<quint64>> candidates; // 가장 짧은 공급원의 목록들 (오름차순)
+    quint32 camera = 0;
+    QSet<quint32> functions;
+    std::vector<QSet<quint32>> words;             // 검색 단어별 일치 문자열 ID
+};
+
+#endif // EVENTQUERY_H
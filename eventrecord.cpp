@@ -0,0 +1,95 @@
+#include "eventrecord.h"
+#include "eventstore.h"
+
+#include <QDateTime>
+#include <QHash>
+#include <QReadWriteLock>
+#include <QVector>
+
+namespace {
+struct StringPool {
+    QReadWriteLock lock;
+    QHash<QString, quint32> ids;
+    QVector<QString> texts{QString()};   // 0번은 빈 문자열
+};
+
+StringPool &pool()
+{
+    static StringPool instance;
+    return instance;
+}
+}
+
+quint32 EventStrings::intern(const QString &text)
+{
+    if (text.isEmpty()) return 0;
+
+    StringPool &p = pool();
+    {
+        QReadLocker locker(&p.lock);
+        auto it = p.ids.constFind(text);
+        if (it != p.ids.constEnd()) return it.value();
+    }
+
+    QWriteLocker locker(&p.lock);
+    auto it = p.ids.constFind(text);   // 잠금 사이에 다른 스레드가 등록했을 수 있음
+    if (it != p.ids.constEnd()) return it.value();
+
+    const quint32 id = quint32(p.texts.size());
+    p.texts.append(text);
+    p.ids.insert(text, id);
+    return id;
+}
+
+quint32 EventStrings::find(const QString &text)
+{
+    StringPool &p = pool();
+    QReadLocker locker(&p.lock);
+    return p.ids.value(text, 0);
+}
+
+QString EventStrings::text(quint32 id)
+{
+    StringPool &p = pool();
+    QReadLocker locker(&p.lock);
+    return id < quint32(p.texts.size()) ? p.texts[id] : QString();
+}
+
+EventRecord EventRecord::fromEntry(const LogEntry &entry, qint64 fallbackTime)
+{
+    EventRecord record;
+    const qint64 time = EventStore::toEpochMs(entry.timestamp);
+    record.time = time != 0 ? time : fallbackTime;
+    record.camera = EventStrings::intern(entry.cameraName);
+    record.function = EventStrings::intern(entry.function);
+    record.event = EventStrings::intern(entry.event);
+    record.details = entry.details;
+
+    // "http://<ip>/<path>" → 기본 주소는 인터닝, 경로만 개별 보관
+    const QString &url = entry.imageUrl;
+    const int schemeEnd = url.indexOf("://");
+    const int baseEnd = schemeEnd < 0 ? -1 : url.indexOf('/', schemeEnd + 3);
+    if (baseEnd < 0) {
+        record.imagePath = url;
+    } else {
+        record.imageBase = EventStrings::intern(url.left(baseEnd + 1));
+        record.imagePath = url.mid(baseEnd + 1);
+    }
+    return record;
+}
+
+QString EventRecord::timestampText() const
+{
+    return QDateTime::fromMSecsSinceEpoch(time).toString("yyyy-MM-dd HH:mm:ss");
+}
+
+QString EventRecord::imageUrl() const
+{
+    if (imageBase == 0) return imagePath;
+    return EventStrings::text(imageBase) + imagePath;
+}
+
+LogEntry EventRecord::toEntry() const
+{
+    return LogEntry{cameraName(), functionName(), eventText(), timestampText(), imageUrl(), details};
+}
@@ -0,0 +1,46 @@
+#ifndef EVENTRECORD_H
+#define EVENTRECORD_H
+
+#include "logentry.h"
+
+#include <QString>
+
+// ✅ 반복되는 문자열 인터닝 (카메라 이름, 기능, 이벤트 문구, 이미지 기본 주소)
+//    한 번 등록된 ID는 앱 종료까지 유지, 어느 스레드에서나 읽기 가능
+class EventStrings
+{
+public:
+    static quint32 intern(const QString &text);
+    static quint32 find(const QString &text);   // 등록 안 된 문자열이면 0
+    static QString text(quint32 id);             // 0 → 빈 문자열
+};
+
+// ✅ 이력 보관용 압축 이벤트 (LogEntry 문자열 → ID 4개 + 시각 + 상대 경로 + 부가 정보)
+//    표시할 때만 toEntry()로 문자열 조립
+struct EventRecord {
+    qint64 time = 0;            // epoch ms
+    quint32 camera = 0;         // EventStrings ID
+    quint32 function = 0;
+    quint32 event = 0;
+    quint32 imageBase = 0;      // "http://<ip>/" (이미지 없으면 0)
+    QString imagePath;          // 기본 주소 뒤 상대 경로
+    QString details;            // 항목마다 달라 인터닝하지 않음 (없으면 빈 문자열)
+
+    // 시각이 없는 로그(서버 시각 미포함)는 fallbackTime 사용
+    static EventRecord fromEntry(const LogEntry &entry, qint64 fallbackTime);
+    LogEntry toEntry() const;
+
+    QString cameraName() const { return EventStrings::text(camera); }
+    QString functionName() const { return EventStrings::text(function); }
+    QString eventText() const { return EventStrings::text(event); }
+    QString timestampText() const;
+    QString imageUrl() const;
+
+    // 같은 이벤트인지 (시각 + 카메라 + 기능 + 이미지)
+    bool sameEvent(const EventRecord &other) const {
+        return time == other.time && camera == other.camera && function == other.function &&
+               imageBase == other.imageBase && imagePath == other.imagePath;
+    }
+};
+
+#endif // EVENTRECORD_H
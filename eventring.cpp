@@ -0,0 +1,338 @@
+#include "eventring.h"
+
+#include <QDateTime>
+#include <QSet>
+
+#include <algorithm>
+#include <iterator>
+
+namespace {
+bool earlier(const EventRecord &a, const EventRecord &b)
+{
+    return a.time < b.time;
+}
+}
+
+EventRing::EventRing(int capacity, qint64 maxAgeMs, QObject *parent)
+    : QObject(parent), capacity(capacity), maxAgeMs(maxAgeMs)
+{
+}
+
+void EventRing::detach(std::shared_ptr<EventSnapshot::Chunk> &chunk)
+{
+    // 사본이 들고 있는 덩어리는 그대로 두고 복사본을 고침
+    if (chunk.use_count() > 1)
+        chunk = std::make_shared<EventSnapshot::Chunk>(*chunk);
+}
+
+void EventRing::pushBack(EventRecord record)
+{
+    if (data.chunks.empty() || data.chunks.back()->records.size() == EventSnapshot::chunkSize) {
+        auto chunk = std::make_shared<EventSnapshot::Chunk>();
+        chunk->records.reserve(EventSnapshot::chunkSize);
+        data.chunks.push_back(std::move(chunk));
+    } else {
+        detach(data.chunks.back());
+    }
+    data.chunks.back()->records.append(std::move(record));
+    ++data.tail;
+}
+
+QVector<EventRecord> EventRing::takeFrom(quint64 seq)
+{
+    QVector<EventRecord> removed;
+    if (seq >= data.tail) return removed;
+
+    removed.reserve(int(data.tail - seq));
+    for (quint64 s = seq; s < data.tail; ++s)
+        removed.append(data.at(s));
+
+    // seq가 든 덩어리는 앞부분만 남기고, 그 뒤 덩어리는 버림
+    const quint64 offset = seq - data.base;
+    const size_t keepChunks = size_t(offset / EventSnapshot::chunkSize);
+    const int keepInLast = int(offset % EventSnapshot::chunkSize);
+    data.chunks.resize(keepChunks + (keepInLast > 0 ? 1 : 0));
+    if (keepInLast > 0) {
+        detach(data.chunks.back());
+        data.chunks.back()->records.resize(keepInLast);
+    }
+    data.tail = seq;
+    return removed;
+}
+
+void EventRing::append(const LogEntry &entry)
+{
+    EventRecord record = EventRecord::fromEntry(entry, QDateTime::currentMSecsSinceEpoch());
+    counts.add(record);
+    if (data.isEmpty() || record.time >= data.timeAt(data.tail - 1)) {
+        pushBack(std::move(record));
+        indexRecord(data.tail - 1);   // 맨 뒤 추가: 각 목록 끝에 붙이기만
+        evict();
+        emit changed(data.tail - 1);
+    } else {
+        // 늦게 도착한 이벤트: 보통 꼬리 근처라 뒤쪽 몇 개만 다시 씀
+        quint64 seq = data.lowerBound(record.time);
+        while (seq < data.tail && data.timeAt(seq) == record.time) ++seq;   // 같은 시각이면 기존 항목 뒤
+        QVector<EventRecord> tail = takeFrom(seq);
+        pushBack(std::move(record));
+        for (EventRecord &moved : tail)
+            pushBack(std::move(moved));
+        indexFrom(seq);
+        ++data.revision;
+        evict();
+        emit changed(seq);
+    }
+}
+
+void EventRing::merge(const QVector<LogEntry> &entries)
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QVector<EventRecord> incoming;
+    incoming.reserve(entries.size());
+    for (const LogEntry &entry : entries)
+        incoming.append(EventRecord::fromEntry(entry, now));
+    merge(std::move(incoming));
+}
+
+void EventRing::merge(QVector<EventRecord> incoming)
+{
+    sortRun(incoming);
+    std::vector<QVector<EventRecord>> runs;
+    runs.push_back(std::move(incoming));
+    mergeRuns(std::move(runs));
+}
+
+void EventRing::sortRun(QVector<EventRecord> &run)
+{
+    if (std::is_sorted(run.begin(), run.end(), earlier)) return;
+
+    // 카메라 API는 최신 순으로 주는 경우가 많음 → 뒤집기만 하면 됨
+    std::reverse(run.begin(), run.end());
+    if (!std::is_sorted(run.begin(), run.end(), earlier))
+        std::stable_sort(run.begin(), run.end(), earlier);
+}
+
+void EventRing::mergeRuns(std::vector<QVector<EventRecord>> runs)
+{
+    runs.erase(std::remove_if(runs.begin(), runs.end(), [](const QVector<EventRecord> &run) { return run.isEmpty(); }),
+               runs.end());
+    if (runs.empty()) return;
+
+    qint64 earliest = runs.front().front().time;
+    for (const QVector<EventRecord> &run : runs) {
+        earliest = std::min(earliest, run.front().time);
+        for (const EventRecord &record : run)
+            counts.add(record);
+    }
+
+    // 기존 항목 중 earliest 이후(같은 시각 포함 안 함)만 병합 대상 → 같은 시각이면 기존 항목이 앞
+    quint64 splitSeq = data.lowerBound(earliest);
+    while (splitSeq < data.tail && data.timeAt(splitSeq) == earliest) ++splitSeq;
+    const bool rewritesTail = splitSeq != data.tail;
+    const QVector<EventRecord> tail = takeFrom(splitSeq);
+
+    // run 0 = 기존 꼬리, 나머지는 새 run (시각이 같으면 번호가 작은 run 먼저)
+    std::vector<const QVector<EventRecord> *> sources;
+    sources.push_back(&tail);
+    for (const QVector<EventRecord> &run : runs)
+        sources.push_back(&run);
+
+    struct Head {
+        qint64 time;
+        int source;
+        int index;
+    };
+    auto later = [](const Head &a, const Head &b) {
+        return a.time != b.time ? a.time > b.time : a.source > b.source;
+    };
+    std::vector<Head> heap;
+    for (int i = 0; i < int(sources.size()); ++i) {
+        if (!sources[i]->isEmpty())
+            heap.push_back({sources[i]->front().time, i, 0});
+    }
+    std::make_heap(heap.begin(), heap.end(), later);
+
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), later);
+        Head head = heap.back();
+        heap.pop_back();
+
+        const QVector<EventRecord> &source = *sources[head.source];
+        pushBack(source[head.index]);
+        if (++head.index < source.size()) {
+            head.time = source[head.index].time;
+            heap.push_back(head);
+            std::push_heap(heap.begin(), heap.end(), later);
+        }
+    }
+
+    indexFrom(splitSeq);
+    if (rewritesTail) ++data.revision;
+    evict();
+    emit changed(splitSeq);
+}
+
+void EventRing::clear()
+{
+    data.chunks.clear();
+    data.head = data.tail;
+    data.base = data.tail;
+    byCamera.clear();
+    byFunction.clear();
+    byEvent.clear();
+    byDetailWord.clear();
+    textIndex.clear();
+    counts.clear();
+    ++data.revision;
+    emit changed(data.tail);
+}
+
+void EventRing::evict()
+{
+    const qint64 cutoff = QDateTime::currentMSecsSinceEpoch() - maxAgeMs;
+    while (!data.isEmpty() && (data.size() > capacity || data.timeAt(data.head) < cutoff)) {
+        // 가장 오래된 항목 = 각 목록의 맨 앞
+        const EventRecord &oldest = data.at(data.head);
+        dropOldest(byCamera, oldest.camera);
+        dropOldest(byFunction, oldest.function);
+        dropOldest(byEvent, oldest.event);
+        for (quint32 word : EventTextIndex::detailWordIds(oldest.details, EventStrings::find))
+            dropOldest(byDetailWord, word);
+        counts.remove(oldest);
+        ++data.head;
+
+        // 덩어리 전체가 밀려나면 버림 (사본이 들고 있으면 사본이 끝날 때 해제)
+        if (data.head - data.base >= quint64(EventSnapshot::chunkSize)) {
+            data.chunks.pop_front();
+            data.base += EventSnapshot::chunkSize;
+        }
+    }
+}
+
+void EventRing::dropOldest(QHash<quint32, Postings> &index, quint32 key)
+{
+    auto it = index.find(key);
+    if (it == index.end()) return;
+    it->pop_front();
+    if (it->empty()) index.erase(it);
+}
+
+void EventRing::indexFrom(quint64 seq)
+{
+    for (auto *index : {&byCamera, &byFunction, &byEvent, &byDetailWord}) {
+        for (auto it = index->begin(); it != index->end();) {
+            while (!it->empty() && it->back() >= seq)
+                it->pop_back();
+            it = it->empty() ? index->erase(it) : std::next(it);
+        }
+    }
+    for (quint64 s = seq; s < endSeq(); ++s)
+        indexRecord(s);
+}
+
+void EventRing::indexRecord(quint64 seq)
+{
+    const EventRecord &record = data.at(seq);
+    const quint32 keys[] = {record.camera, record.function, record.event};
+    QHash<quint32, Postings> *indexes[] = {&byCamera, &byFunction, &byEvent};
+    for (int i = 0; i < 3; ++i) {
+        Postings &postings = (*indexes[i])[keys[i]];
+        // 목록이 새로 생길 때만 문자열 색인 확인 (문자열 색인은 clear 전까지 지우지 않음)
+        if (postings.empty()) textIndex.add(keys[i]);
+        postings.push_back(seq);
+    }
+    for (quint32 word : EventTextIndex::detailWordIds(record.details, EventStrings::intern)) {
+        Postings &postings = byDetailWord[word];
+        if (postings.empty()) textIndex.add(word);
+        postings.push_back(seq);
+    }
+}
+
+QVector<quint32> EventRing::cameraIds() const
+{
+    QVector<quint32> ids = byCamera.keys();
+    std::sort(ids.begin(), ids.end(), [&](quint32 a, quint32 b) {
+        return byCamera.constFind(a)->back() > byCamera.constFind(b)->back();
+    });
+    return ids;
+}
+
+EventQueryPlan EventRing::plan(const EventQuery &query, quint64 fromSeq) const
+{
+    EventQueryPlan plan;
+
+    // 시각 구간 → 순번 구간 [lo, hi)
+    plan.lo = std::max(query.fromMs > 0 ? lowerBound(query.fromMs) : firstSeq(), fromSeq);
+    plan.hi = query.toMs > 0 ? lowerBound(query.toMs) : endSeq();
+    if (plan.lo >= plan.hi) {
+        plan.empty = true;
+        return plan;
+    }
+
+    // 목록 중 [lo, hi)에 드는 부분
+    struct Range {
+        Postings::const_iterator begin, end;
+    };
+    // 후보 공급원 = 목록 여러 개의 합집합 (예: 기능 {Fall, Trespass}, 검색어와 일치하는 문구 ID들)
+    struct Source {
+        std::vector<Range> ranges;
+        qsizetype size = 0;
+    };
+    auto addList = [&](Source &source, const QHash<quint32, Postings> &index, quint32 key) {
+        auto it = index.constFind(key);
+        if (it == index.constEnd()) return;
+        Range range{std::lower_bound(it->begin(), it->end(), plan.lo), std::lower_bound(it->begin(), it->end(), plan.hi)};
+        source.size += range.end - range.begin;
+        source.ranges.push_back(range);
+    };
+
+    std::vector<Source> sources;
+    plan.camera = query.camera;
+    if (query.camera != 0) {
+        sources.emplace_back();
+        addList(sources.back(), byCamera, query.camera);
+    }
+
+    if (!query.functions.isEmpty()) {
+        sources.emplace_back();
+        for (quint32 function : query.functions) {
+            if (!plan.functions.contains(function))   // 중복 기능은 한 번만
+                addList(sources.back(), byFunction, function);
+            plan.functions.insert(function);
+        }
+    }
+
+    // 검색어: 단어마다 일치하는 문자열 ID → 카메라/기능/문구/부가 정보 단어 목록의 합집합
+    for (const QString &word : EventTextIndex::words(query.text)) {
+        QSet<quint32> ids = textIndex.match(word);
+        if (ids.isEmpty()) {
+            plan.empty = true;
+            return plan;
+        }
+        sources.emplace_back();
+        for (quint32 id : ids) {
+            addList(sources.back(), byCamera, id);
+            addList(sources.back(), byFunction, id);
+            addList(sources.back(), byEvent, id);
+            addList(sources.back(), byDetailWord, id);
+        }
+        plan.words.push_back(std::move(ids));
+    }
+
+    if (sources.empty()) {
+        plan.scanAll = true;
+        return plan;
+    }
+
+    // 가장 짧은 공급원만 복사 (실행 중 링이 바뀌어도 계획은 그대로)
+    auto shortest = std::min_element(sources.begin(), sources.end(), [](const Source &a, const Source &b) {
+        return a.size < b.size;
+    });
+    if (shortest->size == 0) {
+        plan.empty = true;
+        return plan;
+    }
+    for (const Range &range : shortest->ranges)
+        plan.candidates.emplace_back(range.begin, range.end);
+    return plan;
+}
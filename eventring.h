@@ -0,0 +1,115 @@
+#ifndef EVENTRING_H
+#define EVENTRING_H
+
+#include "logentry.h"
+#include "eventrecord.h"
+#include "eventsnapshot.h"
+#include "eventquery.h"
+#include "eventtextindex.h"
+#include "eventstats.h"
+
+#include <QHash>
+#include <QObject>
+#include <QVector>
+
+#include <deque>
+#include <vector>
+
+// ✅ 메모리 이벤트 보관소 (시각 순, 오래된 것 → 최신)
+//    - 새 이벤트는 꼬리에 추가 O(1), 한도(개수/기간)를 넘으면 머리부터 밀어냄 O(1)
+//    - 안정 순번(seq): 추가/밀려남이 있어도 남아 있는 항목의 순번은 그대로
+//      → 다이얼로그가 복사 없이 순번으로 읽을 수 있음
+//    - 늦게 도착한 과거 이력은 merge로 제자리에 끼워 넣음 (이때만 layoutRevision 증가)
+//    - 항목은 압축 EventRecord로 보관, 문자열은 표시할 때만 조립
+//    - 저장은 공유 덩어리 단위 → snapshot()은 포인터만 복사, 작업 스레드에서 읽어도 안전
+//    - 보조 색인: 카메라별 / 기능별 / 이벤트 문구별 / 부가 정보 단어별 순번 목록 (오름차순), 시각은 링 자체가 정렬 색인
+//      문자열 검색은 EventTextIndex로 문자열 ID를 찾은 뒤 위 목록으로 항목을 찾음
+//      부가 정보는 항목마다 달라 통째로 인터닝하지 않고 단어 단위로 색인 (단어 경계를 넘는 일치는 문구/카메라/기능만)
+//      추가/밀려남/병합 때 함께 갱신 → 필터는 전체를 훑지 않고 색인 구간만 봄
+//    - 분/시/일 집계(EventStats)도 들어오고 밀려날 때 함께 갱신
+//    - 바뀔 때마다 changed(fromSeq) → 열린 뷰는 새 사본과 비교해 바뀐 부분만 반영
+//    GUI 스레드 전용 (사본은 예외)
+class EventRing : public QObject
+{
+    Q_OBJECT
+
+public:
+    EventRing(int capacity, qint64 maxAgeMs, QObject *parent = nullptr);
+
+    int size() const { return data.size(); }
+    bool isEmpty() const { return data.isEmpty(); }
+
+    // 안정 순번 [firstSeq, endSeq)
+    quint64 firstSeq() const { return data.firstSeq(); }
+    quint64 endSeq() const { return data.endSeq(); }
+    bool contains(quint64 seq) const { return data.contains(seq); }
+    const EventRecord &at(quint64 seq) const { return data.at(seq); }
+    qint64 timeAt(quint64 seq) const { return data.timeAt(seq); }
+
+    // 최신 순 접근 (0 = 가장 최근)
+    const EventRecord &newest(int i) const { return data.newest(i); }
+
+    // time 이상인 첫 순번 (없으면 endSeq)
+    quint64 lowerBound(qint64 time) const { return data.lowerBound(time); }
+
+    // 지금 시점의 읽기 전용 사본 (덩어리 포인터만 복사)
+    EventSnapshot snapshot() const { return data; }
+
+    // 조건 → 실행 계획 (같은 시점의 snapshot()으로 실행)
+    //    시각 구간 → 카메라/기능/검색어 후보 중 가장 짧은 목록만 훑고 나머지 조건은 항목으로 확인
+    //    fromSeq: 그 이후 순번만 (열린 뷰에 새로 들어온 부분 반영용)
+    EventQueryPlan plan(const EventQuery &query, quint64 fromSeq = 0) const;
+
+    // 이력이 있는 카메라 ID (최근에 이벤트가 있었던 순), 기능 ID
+    QVector<quint32> cameraIds() const;
+    QVector<quint32> functionIds() const { return byFunction.keys(); }
+
+    // 카메라 × 기능별 분/시/일 건수 (보관 중인 항목 기준)
+    const EventStats &stats() const { return counts; }
+
+    // 중간 삽입으로 순번 ↔ 항목 대응이 바뀔 때마다 증가
+    quint64 layoutRevision() const { return data.revision; }
+
+    // 서버 시각이 없는 로그는 추가 시점의 현재 시각으로 보관
+    void append(const LogEntry &entry);            // 실시간 이벤트
+    void merge(const QVector<LogEntry> &entries);  // 과거 이력 묶음 (순서 무관)
+    void merge(QVector<EventRecord> incoming);
+
+    // 정렬된 묶음(run) 여러 개를 한 번에 k-way 병합
+    //    기존 항목 중 가장 이른 run보다 앞선 부분은 건드리지 않음 → 겹치는 꼬리만 다시 씀
+    //    각 run은 시각 오름차순이어야 함 (sortRun으로 준비)
+    void mergeRuns(std::vector<QVector<EventRecord>> runs);
+
+    // 응답 배열 → 오름차순 run (이미 정렬/역순이면 O(n), 아니면 안정 정렬)
+    static void sortRun(QVector<EventRecord> &run);
+    void clear();
+
+signals:
+    // fromSeq 이후 순번은 새로 추가됐거나 다시 쓰임 (그 앞은 그대로, 머리는 밀려났을 수 있음)
+    void changed(quint64 fromSeq);
+
+private:
+    using Postings = std::deque<quint64>;   // 순번 오름차순 (밀려날 때 앞에서 제거)
+
+    void evict();
+    void indexFrom(quint64 seq);             // seq 이후 색인을 지우고 다시 등록 (중간 삽입/병합 후)
+    void indexRecord(quint64 seq);           // seq 1건을 각 목록 끝에 추가 (seq가 목록의 마지막보다 뒤일 때)
+    static void dropOldest(QHash<quint32, Postings> &index, quint32 key);
+
+    // 덩어리 저장소 조작 (사본과 공유 중인 덩어리는 고치기 전에 복사)
+    void pushBack(EventRecord record);
+    QVector<EventRecord> takeFrom(quint64 seq);   // [seq, endSeq) 떼어 냄
+    static void detach(std::shared_ptr<EventSnapshot::Chunk> &chunk);
+
+    EventSnapshot data;
+    QHash<quint32, Postings> byCamera;
+    QHash<quint32, Postings> byFunction;
+    QHash<quint32, Postings> byEvent;
+    QHash<quint32, Postings> byDetailWord;
+    EventTextIndex textIndex;
+    EventStats counts;
+    int capacity;
+    qint64 maxAgeMs;
+};
+
+#endif // EVENTRING_H
@@ -0,0 +1,15 @@
+#include "eventsnapshot.h"
+
+quint64 EventSnapshot::lowerBound(qint64 time) const
+{
+    quint64 low = head;
+    quint64 high = tail;
+    while (low < high) {
+        const quint64 mid = low + (high - low) / 2;
+        if (at(mid).time < time)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low;
+}
@@ -0,0 +1,57 @@
+#ifndef EVENTSNAPSHOT_H
+#define EVENTSNAPSHOT_H
+
+#include "eventrecord.h"
+
+#include <QVector>
+
+#include <deque>
+#include <memory>
+
+// ✅ 이벤트 보관소의 읽기 전용 시점 사본
+//    항목은 4096개 단위 덩어리(chunk)에 들어 있고 덩어리는 공유 포인터로 보관
+//    → 사본을 만들 때 복사하는 것은 덩어리 포인터뿐 (100만 건 ≈ 250개)
+//    EventRing이 공유 중인 덩어리를 고칠 때는 그 덩어리만 복사 (copy-on-write)
+//    사본은 어느 스레드에서나 읽을 수 있음 (작업 스레드 필터링, 내보내기)
+class EventSnapshot
+{
+public:
+    static constexpr int chunkSize = 4096;
+
+    int size() const { return int(tail - head); }
+    bool isEmpty() const { return tail == head; }
+
+    // 안정 순번 [firstSeq, endSeq)
+    quint64 firstSeq() const { return head; }
+    quint64 endSeq() const { return tail; }
+    bool contains(quint64 seq) const { return seq >= head && seq < tail; }
+    const EventRecord &at(quint64 seq) const {
+        const quint64 offset = seq - base;
+        return chunks[offset / chunkSize]->records[int(offset % chunkSize)];
+    }
+    qint64 timeAt(quint64 seq) const { return at(seq).time; }
+
+    // 최신 순 접근 (0 = 가장 최근)
+    const EventRecord &newest(int i) const { return at(tail - 1 - quint64(i)); }
+
+    // time 이상인 첫 순번 (없으면 endSeq)
+    quint64 lowerBound(qint64 time) const;
+
+    // 만들어질 때의 EventRing::layoutRevision
+    quint64 layoutRevision() const { return revision; }
+
+private:
+    friend class EventRing;
+
+    struct Chunk {
+        QVector<EventRecord> records;   // 마지막 덩어리만 chunkSize보다 적을 수 있음
+    };
+
+    std::deque<std::shared_ptr<Chunk>> chunks;   // chunks[i] = 순번 [base + i*chunkSize, ...)
+    quint64 base = 0;                            // 첫 덩어리의 첫 순번 (밀려난 항목 포함)
+    quint64 head = 0;
+    quint64 tail = 0;
+    quint64 revision = 0;
+};
+
+#endif // EVENTSNAPSHOT_H
@@ -0,0 +1,92 @@
+#include "eventstats.h"
+
+#include <QDateTime>
+
+EventStats::EventStats()
+    : localOffsetMs(qint64(QDateTime::currentDateTime().offsetFromUtc()) * 1000)
+{
+}
+
+qint64 EventStats::bucketWidth(Resolution resolution)
+{
+    switch (resolution) {
+    case Minute: return 60LL * 1000;
+    case Hour:   return 3600LL * 1000;
+    default:     return 24LL * 3600 * 1000;
+    }
+}
+
+qint64 EventStats::bucketStart(qint64 time, Resolution resolution) const
+{
+    const qint64 width = bucketWidth(resolution);
+    const qint64 local = time + localOffsetMs;
+    qint64 start = local - local % width;
+    if (local % width < 0) start -= width;
+    return start - localOffsetMs;
+}
+
+void EventStats::adjust(const EventRecord &record, int delta)
+{
+    if (record.time == 0) return;
+
+    const quint64 k = key(record.camera, record.function);
+    for (int level = 0; level < ResolutionCount; ++level) {
+        Buckets &buckets = levels[level][k];
+        auto it = buckets.emplace(bucketStart(record.time, Resolution(level)), 0).first;
+        it->second += delta;
+        if (it->second <= 0) {
+            buckets.erase(it);
+            if (buckets.empty()) levels[level].remove(k);
+        }
+    }
+}
+
+void EventStats::clear()
+{
+    for (auto &level : levels)
+        level.clear();
+}
+
+QMap<qint64, int> EventStats::series(quint32 camera, quint32 function, Resolution resolution,
+                                     qint64 fromMs, qint64 toMs) const
+{
+    QMap<qint64, int> result;
+    auto it = levels[resolution].constFind(key(camera, function));
+    if (it == levels[resolution].constEnd()) return result;
+
+    for (auto b = it->lower_bound(bucketStart(fromMs, resolution)); b != it->end() && b->first < toMs; ++b)
+        result.insert(b->first, b->second);
+    return result;
+}
+
+QVector<int> EventStats::histogram(quint32 camera, const QVector<quint32> &functions,
+                                   qint64 fromMs, qint64 toMs, int bins) const
+{
+    QVector<int> result(qMax(bins, 0), 0);
+    if (bins <= 0 || toMs <= fromMs) return result;
+
+    // 칸 하나에 구간이 여러 개 들어가는 가장 큰 단계 (없으면 분 단위)
+    const qint64 span = toMs - fromMs;
+    Resolution resolution = Minute;
+    for (int level = Day; level > Minute; --level) {
+        if (bucketWidth(Resolution(level)) * bins <= span) {
+            resolution = Resolution(level);
+            break;
+        }
+    }
+
+    const QHash<quint64, Buckets> &level = levels[resolution];
+    for (auto it = level.constBegin(); it != level.constEnd(); ++it) {
+        const quint32 c = quint32(it.key() >> 32);
+        const quint32 f = quint32(it.key());
+        if (camera != 0 && c != camera) continue;
+        if (!functions.isEmpty() && !functions.contains(f)) continue;
+
+        for (auto b = it->lower_bound(bucketStart(fromMs, resolution)); b != it->end() && b->first < toMs; ++b) {
+            const qint64 offset = qMax(b->first, fromMs) - fromMs;
+            const int bin = int(qMin<qint64>(offset * bins / span, bins - 1));
+            result[bin] += b->second;
+        }
+    }
+    return result;
+}
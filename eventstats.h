@@ -0,0 +1,49 @@
+#ifndef EVENTSTATS_H
+#define EVENTSTATS_H
+
+#include "eventrecord.h"
+
+#include <QHash>
+#include <QMap>
+#include <QVector>
+
+#include <map>
+
+// ✅ 카메라 × 기능별 시간 구간 집계 (분 → 시 → 일 3단계)
+//    이벤트가 들어오고 밀려날 때마다 세 단계를 함께 +1 / -1 → 다시 훑지 않음
+//    구간 경계는 로컬 시각 기준 (일 = 자정~자정)
+//    GUI 스레드 전용
+class EventStats
+{
+public:
+    enum Resolution { Minute, Hour, Day, ResolutionCount };
+
+    EventStats();
+
+    void add(const EventRecord &record) { adjust(record, 1); }
+    void remove(const EventRecord &record) { adjust(record, -1); }
+    void clear();
+
+    static qint64 bucketWidth(Resolution resolution);
+
+    // 카메라 1대 × 기능 1개의 구간별 건수 [fromMs, toMs) (키 = 구간 시작 epoch ms)
+    QMap<qint64, int> series(quint32 camera, quint32 function, Resolution resolution,
+                             qint64 fromMs, qint64 toMs) const;
+
+    // [fromMs, toMs)를 bins칸으로 나눈 밀도 (칸 폭보다 좁은 단계 중 가장 큰 단계 사용)
+    // camera 0 = 전체, functions 비어 있으면 전체
+    QVector<int> histogram(quint32 camera, const QVector<quint32> &functions,
+                           qint64 fromMs, qint64 toMs, int bins) const;
+
+private:
+    using Buckets = std::map<qint64, int>;   // 구간 시작(ms) → 건수
+
+    void adjust(const EventRecord &record, int delta);
+    qint64 bucketStart(qint64 time, Resolution resolution) const;
+    static quint64 key(quint32 camera, quint32 function) { return (quint64(camera) << 32) | function; }
+
+    QHash<quint64, Buckets> levels[ResolutionCount];
+    qint64 localOffsetMs;   // 로컬 자정 정렬용
+};
+
+#endif // EVENTSTATS_H
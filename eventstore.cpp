@@ -0,0 +1,308 @@
+#include "eventstore.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QStandardPaths>
+#include <QtEndian>
+#include <QDebug>
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <vector>
+
+namespace {
+constexpr qint64 kSegmentBytes = 8 * 1024 * 1024;   // 이 크기를 넘으면 다음 세그먼트로
+constexpr qint64 kRetentionDays = 60;                // 교대 근무 기준 몇 주치 + 여유
+
+// 인덱스 레코드 16바이트 (리틀 엔디언): 시각(ms) / 본문 오프셋 / 본문 길이
+constexpr int kIndexRecordSize = 16;
+
+void encodeIndex(uchar *out, qint64 time, quint32 offset, quint32 length)
+{
+    qToLittleEndian<qint64>(time, out);
+    qToLittleEndian<quint32>(offset, out + 8);
+    qToLittleEndian<quint32>(length, out + 12);
+}
+
+void decodeIndex(const uchar *in, qint64 &time, quint32 &offset, quint32 &length)
+{
+    time = qFromLittleEndian<qint64>(in);
+    offset = qFromLittleEndian<quint32>(in + 8);
+    length = qFromLittleEndian<quint32>(in + 12);
+}
+
+QByteArray encodeEntry(const LogEntry &entry)
+{
+    QByteArray bytes;
+    QDataStream stream(&bytes, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << entry.cameraName << entry.function << entry.event << entry.timestamp << entry.imageUrl << entry.details;
+    return bytes;
+}
+
+LogEntry decodeEntry(const uchar *data, quint32 length)
+{
+    // 매핑된 메모리를 복사 없이 감싸서 읽음
+    QByteArray bytes = QByteArray::fromRawData(reinterpret_cast<const char *>(data), length);
+    QDataStream stream(bytes);
+    stream.setVersion(QDataStream::Qt_6_0);
+    LogEntry entry;
+    stream >> entry.cameraName >> entry.function >> entry.event >> entry.timestamp >> entry.imageUrl;
+    if (!stream.atEnd()) stream >> entry.details;   // 이전 형식 항목에는 부가 정보 없음
+    return entry;
+}
+}
+
+EventStore::EventStore(const QString &directory)
+    : dir(directory)
+{
+    if (!QDir().mkpath(dir)) {
+        qWarning() << "[이벤트 저장소] 디렉터리 생성 실패:" << dir;
+        return;
+    }
+
+    QStringList indexFiles = QDir(dir).entryList({"*.idx"}, QDir::Files, QDir::Name);
+    for (const QString &name : indexFiles) {
+        bool ok = false;
+        Segment segment;
+        segment.number = name.section('.', 0, 0).toInt(&ok);
+        if (ok && loadSegment(segment))
+            segments.append(segment);
+    }
+
+    opened = openActive();
+    prune(QDateTime::currentMSecsSinceEpoch() - kRetentionDays * 24 * 3600 * 1000);
+
+    qDebug() << "[이벤트 저장소]" << dir << "세그먼트" << segments.size() << "개, 이벤트" << count() << "건";
+}
+
+EventStore::~EventStore()
+{
+    flush();
+}
+
+QString EventStore::defaultDirectory()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/events";
+}
+
+qint64 EventStore::toEpochMs(const QString &timestamp)
+{
+    QDateTime time = QDateTime::fromString(timestamp, "yyyy-MM-dd HH:mm:ss");
+    return time.isValid() ? time.toMSecsSinceEpoch() : 0;
+}
+
+qint64 EventStore::count() const
+{
+    qint64 total = 0;
+    for (const Segment &segment : segments)
+        total += segment.records;
+    return total;
+}
+
+QString EventStore::segmentPath(int number, const char *suffix) const
+{
+    return QString("%1/%2.%3").arg(dir).arg(number, 6, 10, QChar('0')).arg(QLatin1String(suffix));
+}
+
+// 인덱스를 훑어 시각 범위 계산 + 잘린 꼬리 정리
+bool EventStore::loadSegment(Segment &segment)
+{
+    QFile index(segmentPath(segment.number, "idx"));
+    QFile data(segmentPath(segment.number, "seg"));
+    if (!index.open(QIODevice::ReadWrite) || !data.open(QIODevice::ReadWrite)) return false;
+
+    const qint64 dataFileSize = data.size();
+    qint64 records = index.size() / kIndexRecordSize;
+    qint64 dataEnd = 0;
+
+    if (records > 0) {
+        const uchar *map = index.map(0, records * kIndexRecordSize);
+        if (!map) return false;
+
+        for (qint64 i = 0; i < records; ++i) {
+            qint64 time;
+            quint32 offset, length;
+            decodeIndex(map + i * kIndexRecordSize, time, offset, length);
+            if (qint64(offset) + length > dataFileSize) {
+                records = i;
+                break;
+            }
+            segment.minTime = std::min(segment.minTime, time);
+            segment.maxTime = std::max(segment.maxTime, time);
+            dataEnd = std::max(dataEnd, qint64(offset) + length);
+        }
+        index.unmap(const_cast<uchar *>(map));
+    }
+
+    if (index.size() != records * kIndexRecordSize) index.resize(records * kIndexRecordSize);
+    if (dataFileSize != dataEnd) data.resize(dataEnd);
+
+    segment.records = records;
+    segment.dataSize = dataEnd;
+    return true;
+}
+
+bool EventStore::openActive()
+{
+    if (segments.isEmpty() || segments.last().dataSize >= kSegmentBytes) {
+        Segment segment;
+        segment.number = segments.isEmpty() ? 1 : segments.last().number + 1;
+        segments.append(segment);
+    }
+
+    const Segment &segment = segments.last();
+    activeData = std::make_unique<QFile>(segmentPath(segment.number, "seg"));
+    activeIndex = std::make_unique<QFile>(segmentPath(segment.number, "idx"));
+    if (!activeData->open(QIODevice::ReadWrite) || !activeIndex->open(QIODevice::ReadWrite)) {
+        qWarning() << "[이벤트 저장소] 세그먼트 열기 실패:" << activeData->fileName();
+        activeData.reset();
+        activeIndex.reset();
+        return false;
+    }
+    activeData->seek(segment.dataSize);
+    activeIndex->seek(segment.records * kIndexRecordSize);
+    return true;
+}
+
+void EventStore::write(const LogEntry &entry)
+{
+    if (!activeData) return;
+
+    if (segments.last().dataSize >= kSegmentBytes) {
+        flush();
+        if (!openActive()) return;
+    }
+
+    qint64 time = toEpochMs(entry.timestamp);
+    if (time == 0) time = QDateTime::currentMSecsSinceEpoch();   // 서버 시각이 없는 로그
+
+    Segment &segment = segments.last();
+    const QByteArray payload = encodeEntry(entry);
+    uchar record[kIndexRecordSize];
+    encodeIndex(record, time, quint32(segment.dataSize), quint32(payload.size()));
+
+    // 본문 → 인덱스 순서 (중간에 끊겨도 인덱스가 없는 본문은 열 때 잘림)
+    activeData->write(payload);
+    activeIndex->write(reinterpret_cast<const char *>(record), kIndexRecordSize);
+
+    segment.dataSize += payload.size();
+    segment.records += 1;
+    segment.minTime = std::min(segment.minTime, time);
+    segment.maxTime = std::max(segment.maxTime, time);
+}
+
+void EventStore::flush() const
+{
+    if (activeData) activeData->flush();
+    if (activeIndex) activeIndex->flush();
+}
+
+void EventStore::append(const LogEntry &entry)
+{
+    write(entry);
+    flush();
+}
+
+void EventStore::append(const QVector<LogEntry> &entries)
+{
+    for (const LogEntry &entry : entries)
+        write(entry);
+    flush();
+}
+
+// budgetAtFrom: 시각이 정확히 fromMs인 레코드는 이 개수까지만 (readNewest의 경계 시각)
+void EventStore::readSegment(const Segment &segment, qint64 fromMs, qint64 toMs,
+                             QVector<EventRecord> &out, qint64 *budgetAtFrom) const
+{
+    if (segment.records == 0 || segment.maxTime < fromMs || segment.minTime > toMs) return;
+
+    QFile index(segmentPath(segment.number, "idx"));
+    QFile data(segmentPath(segment.number, "seg"));
+    if (!index.open(QIODevice::ReadOnly) || !data.open(QIODevice::ReadOnly)) return;
+
+    const uchar *indexMap = index.map(0, segment.records * kIndexRecordSize);
+    const uchar *dataMap = data.map(0, segment.dataSize);
+    if (indexMap && dataMap) {
+        for (qint64 i = 0; i < segment.records; ++i) {
+            qint64 time;
+            quint32 offset, length;
+            decodeIndex(indexMap + i * kIndexRecordSize, time, offset, length);
+            if (time < fromMs || time > toMs) continue;
+            if (budgetAtFrom && time == fromMs) {
+                if (*budgetAtFrom <= 0) continue;
+                --*budgetAtFrom;
+            }
+            out.append(EventRecord::fromEntry(decodeEntry(dataMap + offset, length), time));
+        }
+    }
+    // 파일을 닫으면 매핑도 해제됨
+}
+
+QVector<EventRecord> EventStore::read(qint64 fromMs, qint64 toMs) const
+{
+    flush();   // 기록 중 세그먼트의 버퍼 내용까지 매핑에 보이도록
+
+    QVector<EventRecord> records;
+    for (const Segment &segment : segments)
+        readSegment(segment, fromMs, toMs, records);
+    return records;
+}
+
+QVector<EventRecord> EventStore::readNewest(int limit, qint64 fromMs) const
+{
+    if (limit <= 0) return {};
+    flush();
+
+    // 1) 인덱스만 훑어 최신 limit건의 경계 시각 (최소 힙 = 지금까지 가장 늦은 limit개)
+    std::priority_queue<qint64, std::vector<qint64>, std::greater<qint64>> newest;
+    for (int s = segments.size() - 1; s >= 0; --s) {
+        const Segment &segment = segments[s];
+        if (segment.records == 0 || segment.maxTime < fromMs) continue;
+        if (int(newest.size()) == limit && segment.maxTime <= newest.top()) continue;
+
+        QFile index(segmentPath(segment.number, "idx"));
+        if (!index.open(QIODevice::ReadOnly)) continue;
+        const uchar *indexMap = index.map(0, segment.records * kIndexRecordSize);
+        if (!indexMap) continue;
+        for (qint64 i = 0; i < segment.records; ++i) {
+            qint64 time;
+            quint32 offset, length;
+            decodeIndex(indexMap + i * kIndexRecordSize, time, offset, length);
+            if (time < fromMs) continue;
+            if (int(newest.size()) < limit) {
+                newest.push(time);
+            } else if (time > newest.top()) {
+                newest.pop();
+                newest.push(time);
+            }
+        }
+    }
+    if (newest.empty()) return {};
+
+    // 2) 경계 시각 이후만 디코딩 (경계 시각과 같은 레코드는 힙에 든 개수만큼)
+    const qint64 cutoff = newest.top();
+    qint64 atCutoff = 0;
+    for (; !newest.empty() && newest.top() == cutoff; newest.pop())
+        ++atCutoff;
+
+    QVector<EventRecord> records;
+    records.reserve(limit);
+    for (const Segment &segment : segments)
+        readSegment(segment, cutoff, std::numeric_limits<qint64>::max(), records, &atCutoff);
+    return records;
+}
+
+void EventStore::prune(qint64 olderThanMs)
+{
+    for (int i = segments.size() - 2; i >= 0; --i) {
+        const Segment &segment = segments[i];
+        if (segment.records > 0 && segment.maxTime >= olderThanMs) continue;
+
+        QFile::remove(segmentPath(segment.number, "seg"));
+        QFile::remove(segmentPath(segment.number, "idx"));
+        segments.remove(i);
+    }
+}
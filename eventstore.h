@@ -0,0 +1,74 @@
+#ifndef EVENTSTORE_H
+#define EVENTSTORE_H
+
+#include "logentry.h"
+#include "eventrecord.h"
+
+#include <QFile>
+#include <QString>
+#include <QVector>
+
+#include <limits>
+#include <memory>
+
+// ✅ 로컬 이벤트 저장소 (재시작해도 이력 유지)
+//    - 세그먼트 파일에 추가만 함 (NNNNNN.seg: 레코드 본문, NNNNNN.idx: 시각 인덱스)
+//    - 세그먼트가 일정 크기를 넘으면 새 세그먼트로 넘어감, 오래된 세그먼트는 통째로 삭제
+//    - 읽기는 인덱스/본문 모두 메모리 매핑, 시각 범위 밖 세그먼트는 열지 않음
+//    - 기록 중 종료로 잘린 꼬리 레코드는 열 때 잘라냄
+//    GUI 스레드 전용
+class EventStore
+{
+public:
+    explicit EventStore(const QString &directory = defaultDirectory());
+    ~EventStore();
+
+    EventStore(const EventStore &) = delete;
+    EventStore &operator=(const EventStore &) = delete;
+
+    static QString defaultDirectory();
+
+    // "yyyy-MM-dd HH:mm:ss" → epoch ms (형식이 다르면 0)
+    static qint64 toEpochMs(const QString &timestamp);
+
+    bool isOpen() const { return opened; }
+    qint64 count() const;
+
+    void append(const LogEntry &entry);
+    void append(const QVector<LogEntry> &entries);   // 한 번에 기록 (flush 1회)
+
+    // [fromMs, toMs] 구간의 이벤트 (기록 순서, 시각은 인덱스 기준)
+    QVector<EventRecord> read(qint64 fromMs = 0, qint64 toMs = std::numeric_limits<qint64>::max()) const;
+
+    // fromMs 이후 이벤트 중 시각이 가장 늦은 limit건 (기록 순서)
+    //    인덱스(16바이트)만 먼저 훑어 기준 시각을 정하고, 본문은 그 이후만 디코딩 → 메모리/시간 모두 limit에 비례
+    QVector<EventRecord> readNewest(int limit, qint64 fromMs = 0) const;
+
+    // 마지막 이벤트가 olderThanMs 이전인 세그먼트 삭제 (기록 중 세그먼트는 유지)
+    void prune(qint64 olderThanMs);
+
+private:
+    struct Segment {
+        int number = 0;
+        qint64 records = 0;
+        qint64 dataSize = 0;
+        qint64 minTime = std::numeric_limits<qint64>::max();
+        qint64 maxTime = std::numeric_limits<qint64>::min();
+    };
+
+    QString segmentPath(int number, const char *suffix) const;
+    bool loadSegment(Segment &segment);
+    void readSegment(const Segment &segment, qint64 fromMs, qint64 toMs,
+                     QVector<EventRecord> &out, qint64 *budgetAtFrom = nullptr) const;
+    bool openActive();
+    void write(const LogEntry &entry);
+    void flush() const;
+
+    QString dir;
+    bool opened = false;
+    QVector<Segment> segments;               // 번호 순, 마지막이 기록 중
+    std::unique_ptr<QFile> activeData;
+    std::unique_ptr<QFile> activeIndex;
+};
+
+#endif // EVENTSTORE_H
@@ -0,0 +1,133 @@
+#include "eventtextindex.h"
+#include "eventrecord.h"
+
+#include <algorithm>
+
+namespace {
+bool isHangul(QChar ch)
+{
+    const ushort u = ch.unicode();
+    return (u >= 0xAC00 && u <= 0xD7A3) || (u >= 0x1100 && u <= 0x11FF) || (u >= 0x3130 && u <= 0x318F);
+}
+
+QString normalize(const QString &text)
+{
+    return text.normalized(QString::NormalizationForm_KC).toLower();
+}
+}
+
+QStringList EventTextIndex::words(const QString &text)
+{
+    QStringList result;
+    QString current;
+    for (QChar ch : normalize(text)) {
+        if (ch.isLetterOrNumber()) {
+            current += ch;
+        } else if (!current.isEmpty()) {
+            result.append(current);
+            current.clear();
+        }
+    }
+    if (!current.isEmpty()) result.append(current);
+    return result;
+}
+
+QVector<quint32> EventTextIndex::detailWordIds(const QString &details, quint32 (*lookup)(const QString &))
+{
+    QVector<quint32> ids;
+    if (details.isEmpty()) return ids;
+    for (const QString &word : words(details)) {
+        // 자릿수가 긴 숫자(초 이하 시각, 일련번호)는 찾을 일이 없고 문자열 풀만 키움
+        if (word.size() > 4 && std::all_of(word.begin(), word.end(), [](QChar ch) { return ch.isDigit(); }))
+            continue;
+        const quint32 id = lookup(word);
+        if (id != 0 && !ids.contains(id)) ids.append(id);
+    }
+    return ids;
+}
+
+EventTextIndex::Text EventTextIndex::prepare(const QString &text)
+{
+    const QString source = normalize(text);
+    Text result;
+    result.compact.reserve(source.size());
+    result.wordStarts.resize(int(source.size()));
+
+    bool inWord = false;
+    for (QChar ch : source) {
+        if (!ch.isLetterOrNumber()) {
+            inWord = false;
+            continue;
+        }
+        if (!inWord) result.wordStarts.setBit(int(result.compact.size()));
+        result.compact += ch;
+        inWord = true;
+    }
+    result.wordStarts.resize(int(result.compact.size()));
+    return result;
+}
+
+bool EventTextIndex::contains(const Text &text, const QString &word)
+{
+    // 1글자, 한글이 아닌 2글자: 단어 첫머리에서만 ("c"가 모든 단어에 걸리지 않게)
+    // 숫자로 시작: 앞 글자가 숫자면 다른 수의 일부 ("3명"이 "13명"에 걸리지 않게)
+    const bool wordStartOnly = word.size() == 1 || (word.size() == 2 && !isHangul(word[0]));
+    const bool number = word[0].isDigit();
+    for (qsizetype at = text.compact.indexOf(word); at >= 0; at = text.compact.indexOf(word, at + 1)) {
+        const bool wordStart = text.wordStarts.testBit(int(at));
+        if (wordStartOnly && !wordStart) continue;
+        if (number && !wordStart && text.compact[at - 1].isDigit()) continue;
+        return true;
+    }
+    return false;
+}
+
+void EventTextIndex::add(quint32 stringId)
+{
+    if (stringId == 0 || texts.contains(stringId)) return;
+
+    Text text = prepare(EventStrings::text(stringId));
+    const QString &compact = text.compact;
+    for (int i = 0; i < compact.size(); ++i) {
+        postings[compact.mid(i, 1)].insert(stringId);
+        if (i + 1 < compact.size())
+            postings[compact.mid(i, 2)].insert(stringId);
+    }
+    texts.insert(stringId, std::move(text));
+}
+
+void EventTextIndex::clear()
+{
+    postings.clear();
+    texts.clear();
+}
+
+QSet<quint32> EventTextIndex::match(const QString &word) const
+{
+    // 1글자는 글자 자체, 그 이상은 인접 2글자 전부 중 가장 드문 것으로 후보를 좁힘
+    const QString needle = words(word).join(QString());
+    if (needle.isEmpty()) return {};
+
+    QStringList keys;
+    if (needle.size() == 1) {
+        keys.append(needle);
+    } else {
+        for (int i = 0; i + 1 < needle.size(); ++i)
+            keys.append(needle.mid(i, 2));
+    }
+
+    const QSet<quint32> *smallest = nullptr;
+    for (const QString &key : keys) {
+        auto it = postings.constFind(key);
+        if (it == postings.constEnd()) return {};
+        if (!smallest || it->size() < smallest->size())
+            smallest = &it.value();
+    }
+
+    QSet<quint32> result;
+    for (quint32 id : *smallest) {
+        if (contains(*texts.constFind(id), needle))
+            result.insert(id);
+    }
+    return result;
+}
@@ -0,0 +1,49 @@
+#ifndef EVENTTEXTINDEX_H
+#define EVENTTEXTINDEX_H
+
+#include <QBitArray>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// ✅ 이벤트 문자열 역색인 (검색어 → 그 검색어를 포함하는 EventStrings ID)
+//    이벤트 문구/카메라 이름/기능/부가 정보 단어는 인터닝돼 있어 서로 다른 문자열이 적음
+//    → 문자열 단위로 색인하고, 항목은 EventRing의 ID별 순번 목록으로 찾음
+//    정규화: 소문자 + NFKC 후 글자/숫자만 남기고 이어 붙임 (공백, 괄호, 이모지 제거)
+//      → "헬멧미착용"이 "헬멧 미착용"에 일치 (띄어쓰기와 무관)
+//    gram: 이어 붙인 문자열의 글자 1개 + 인접 2글자 (단어 경계를 넘는 2글자 포함)
+//    짧은 검색어는 단어 첫머리에서만, 숫자로 시작하는 검색어는 숫자 중간이 아닐 때만 일치
+//      → "3명"은 "13명"에 일치하지 않음
+//    GUI 스레드 전용
+class EventTextIndex
+{
+public:
+    // 새 문자열 등록 (이미 등록된 ID는 무시)
+    void add(quint32 stringId);
+    void clear();
+
+    // 검색어 한 단어(words 결과)를 포함하는 문자열 ID (가장 드문 gram으로 후보를 좁힌 뒤 확인)
+    QSet<quint32> match(const QString &word) const;
+
+    // 검색창 입력 → 단어 목록 (모든 단어를 만족해야 일치)
+    static QStringList words(const QString &text);
+
+    // 부가 정보 → 색인할 단어 ID (중복 제거), lookup = EventStrings::intern(등록) 또는 find(조회)
+    //    어느 스레드에서나 호출 가능 (작업 스레드의 조건 확인에도 씀)
+    static QVector<quint32> detailWordIds(const QString &details, quint32 (*lookup)(const QString &));
+
+private:
+    struct Text {
+        QString compact;        // 정규화 후 글자/숫자만 이어 붙인 문자열
+        QBitArray wordStarts;   // compact의 각 위치가 원래 단어의 첫 글자인지
+    };
+    static Text prepare(const QString &text);
+    static bool contains(const Text &text, const QString &word);
+
+    QHash<QString, QSet<quint32>> postings;   // gram → 문자열 ID
+    QHash<quint32, Text> texts;               // 문자열 ID → 정규화된 원문 (최종 확인용)
+};
+
+#endif // EVENTTEXTINDEX_H
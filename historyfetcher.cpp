@@ -0,0 +1,209 @@
+#include "historyfetcher.h"
+#include "imagedecoder.h"
+#include "networkclient.h"
+
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QNetworkReply>
+#include <QThreadPool>
+#include <QUrlQuery>
+#include <QDebug>
+
+#include <algorithm>
+
+namespace {
+struct Endpoint {
+    const char *path;        // /api/<path>
+    const char *arrayKey;    // 응답 배열 키
+};
+
+Endpoint endpointFor(const QString &function)
+{
+    if (function == "Trespass") return {"trespass", "trespass"};
+    if (function == "Fall") return {"fall", "fall"};
+    return {"detections", "detections"};
+}
+
+QString imageUrlFor(const QString &ip, const QString &imgPath)
+{
+    if (imgPath.isEmpty()) return QString();
+    QString cleanPath = imgPath.startsWith("../") ? imgPath.mid(3) : imgPath;
+    return QString("http://%1/%2").arg(ip, cleanPath);
+}
+
+HistoryFetcher::Result resultFor(QNetworkReply *reply)
+{
+    // 408(시간 초과), 429(요청 과다)는 잠시 뒤 다시 보내면 될 수 있음
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (status >= 400 && status < 500 && status != 408 && status != 429)
+        return HistoryFetcher::Rejected;
+    return HistoryFetcher::Failed;
+}
+
+// 작업 스레드에서 호출: 응답 1페이지 → LogEntry (문구는 실시간 로그와 동일)
+LogEntry parseItem(const CameraInfo &camera, const QString &function, const QJsonObject &obj)
+{
+    const QString ts = obj["timestamp"].toString();
+    const QString imageUrl = imageUrlFor(camera.ip, obj["image_path"].toString());
+
+    // 문구/부가 정보는 실시간 이벤트(EventIngestWorker)와 같은 형식
+    QString event;
+    QString details;
+    if (function == "PPE") {
+        int person = obj["person_count"].toInt();
+        int helmet = obj["helmet_count"].toInt();
+        int vest = obj["safety_vest_count"].toInt();
+        details = QString("👷 %1명 | ⛑️ %2명 | 🦺 %3명").arg(person).arg(helmet).arg(vest);
+        if (obj.contains("avg_confidence"))
+            details += QString(" | 신뢰도: %1").arg(obj["avg_confidence"].toDouble(), 0, 'f', 2);
+        if (helmet < person && vest >= person)
+            event = "⛑️ 헬멧 미착용 감지";
+        else if (vest < person && helmet >= person)
+            event = "🦺 조끼 미착용 감지";
+        else
+            event = "⛑️ 🦺 PPE 미착용 감지";
+    } else if (function == "Trespass") {
+        event = QString("🚷 무단 침입 감지 (%1명)").arg(obj["count"].toInt());
+        details = QString("감지 시각: %1 | 침입자 수: %2").arg(ts).arg(obj["count"].toInt());
+    } else {
+        event = "🚨 낙상 감지";
+        details = QString("낙상 감지 시각: %1").arg(ts);
+    }
+    return {camera.name, function, event, ts, imageUrl, details};
+}
+}
+
+HistoryFetcher *HistoryFetcher::instance()
+{
+    static HistoryFetcher *fetcher = new HistoryFetcher();
+    return fetcher;
+}
+
+HistoryFetcher::HistoryFetcher(QObject *parent)
+    : QObject(parent)
+{
+    // 카메라 삭제로 요청이 취소되면 핸들러가 불리지 않으므로 슬롯 정리
+    connect(NetworkClient::instance(), &NetworkClient::hostCancelled, this, &HistoryFetcher::cancelCamera);
+}
+
+const QStringList &HistoryFetcher::functions()
+{
+    static const QStringList list = {"PPE", "Trespass", "Fall"};
+    return list;
+}
+
+void HistoryFetcher::fetch(const CameraInfo &camera, const QString &function, qint64 sinceMs)
+{
+    Job job;
+    job.id = nextId++;
+    job.camera = camera;
+    job.function = function;
+    job.sinceMs = sinceMs;
+    if (sinceMs > 0)
+        job.pageSince = QDateTime::fromMSecsSinceEpoch(sinceMs).toString("yyyy-MM-dd HH:mm:ss");
+
+    queue.push_back(std::move(job));
+    dispatch();
+}
+
+void HistoryFetcher::cancelCamera(const QString &ip)
+{
+    queue.erase(std::remove_if(queue.begin(), queue.end(), [&](const Job &job) {
+                    return job.camera.ip == ip;
+                }), queue.end());
+
+    for (auto it = active.begin(); it != active.end();) {
+        if (it->ip == ip) {
+            if (it->requestId) NetworkClient::instance()->cancel(it->requestId);
+            it = active.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    dispatch();
+}
+
+void HistoryFetcher::dispatch()
+{
+    while (active.size() < maxConcurrent && !queue.empty()) {
+        Job job = std::move(queue.front());
+        queue.pop_front();
+        startPage(std::move(job));
+    }
+}
+
+void HistoryFetcher::startPage(Job job)
+{
+    const Endpoint endpoint = endpointFor(job.function);
+    QUrl url(QString("https://%1:8443/api/%2").arg(job.camera.ip, QLatin1String(endpoint.path)));
+    QUrlQuery query;
+    if (!job.pageSince.isEmpty())
+        query.addQueryItem("since", job.pageSince);
+    query.addQueryItem("limit", QString::number(pageSize));
+    url.setQuery(query);
+
+    const quint64 jobId = job.id;
+    active.insert(jobId, {job.camera.ip, 0});
+
+    const quint64 requestId = NetworkClient::instance()->get(QNetworkRequest(url), NetworkClient::Normal, this,
+                                                             [=](QNetworkReply *reply) {
+        auto it = active.find(jobId);
+        if (it == active.end()) return;
+        it->requestId = 0;
+
+        if (reply->error() != QNetworkReply::NoError) {
+            qWarning() << "[이력 페이지 실패]" << job.camera.ip << job.function << reply->errorString();
+            onPageParsed(job, {}, QString(), false, resultFor(reply));
+            return;
+        }
+
+        // 페이지 파싱은 작업 스레드 (UI 스레드는 결과 병합만)
+        const QByteArray bytes = reply->readAll();
+        const QString arrayKey = QLatin1String(endpoint.arrayKey);
+        ImageDecoder::pool()->start([=]() {
+            QJsonDocument doc = QJsonDocument::fromJson(bytes);
+            QVector<LogEntry> entries;
+            QString lastTimestamp;
+            bool hasMore = false;
+            const bool ok = doc.isObject();
+            if (ok) {
+                const QJsonArray arr = doc[arrayKey].toArray();
+                entries.reserve(arr.size());
+                for (const QJsonValue &val : arr) {
+                    LogEntry entry = parseItem(job.camera, job.function, val.toObject());
+                    if (entry.timestamp > lastTimestamp) lastTimestamp = entry.timestamp;
+                    entries.append(std::move(entry));
+                }
+                // has_more가 없으면 페이지를 모르는 서버 → 더 요청하지 않음
+                hasMore = doc["has_more"].toBool(false) && !arr.isEmpty();
+            }
+            QMetaObject::invokeMethod(this, [=]() {
+                onPageParsed(job, entries, lastTimestamp, hasMore, ok ? Ok : Failed);
+            }, Qt::QueuedConnection);
+        });
+    }, NetworkClient::IgnoreSslErrors);
+
+    auto it = active.find(jobId);
+    if (it != active.end()) it->requestId = requestId;
+}
+
+void HistoryFetcher::onPageParsed(Job job, const QVector<LogEntry> &entries, const QString &lastTimestamp,
+                                  bool hasMore, Result result)
+{
+    if (!active.remove(job.id)) return;   // 그 사이 취소됨
+
+    if (!entries.isEmpty())
+        emit pageReady(job.camera.ip, job.function, job.sinceMs, entries);
+
+    // 시각 문자열은 "yyyy-MM-dd HH:mm:ss"라 문자열 비교 = 시각 비교
+    if (result == Ok && hasMore && !lastTimestamp.isEmpty() && lastTimestamp > job.pageSince) {
+        job.pageSince = lastTimestamp;
+        ++job.pages;
+        queue.push_back(std::move(job));   // 다른 카메라 요청 뒤로 (번갈아 진행)
+    } else {
+        emit finished(job.camera.ip, job.function, result);
+    }
+    dispatch();
+}
@@ -0,0 +1,77 @@
+#ifndef HISTORYFETCHER_H
+#define HISTORYFETCHER_H
+
+#include "camerainfo.h"
+#include "logentry.h"
+
+#include <QObject>
+#include <QHash>
+#include <QVector>
+
+#include <deque>
+
+// ✅ 카메라 이력 페이지 수집기 (앱 전체 1개)
+//    - 요청: /api/<endpoint>?since=<마지막 시각>&limit=<페이지 크기>
+//      since는 제외 조건(그 시각 이후만), 응답은 시각 오름차순 + has_more
+//      서버는 마지막 초의 이벤트를 페이지 사이에서 자르지 않음 (limit은 권장값)
+//    - 카메라 전체를 합쳐 동시에 진행하는 이력 요청 수 제한, 다음 페이지는 큐 뒤로 (카메라 간 번갈아)
+//    - 페이지 JSON 파싱은 작업 스레드, 결과만 UI 스레드로
+//    - since/limit을 모르는 서버는 전체 배열 1페이지로 처리
+class HistoryFetcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    static HistoryFetcher *instance();
+
+    // 이력 기능: PPE / Trespass / Fall
+    static const QStringList &functions();
+
+    enum Result {
+        Ok,
+        Failed,     // 연결 실패/5xx/408/429/응답 형식 오류 → 잠시 뒤 다시 시도할 만함
+        Rejected,   // 그 밖의 4xx → 다시 보내도 같음
+    };
+
+    // 카메라 1대 × 기능 1개, sinceMs 이후 (0이면 전체)
+    void fetch(const CameraInfo &camera, const QString &function, qint64 sinceMs);
+    void cancelCamera(const QString &ip);
+
+    void setMaxConcurrent(int count) { maxConcurrent = count; }
+    void setPageSize(int size) { pageSize = size; }
+
+signals:
+    // 파싱 완료된 페이지 (sinceMs: fetch에 넘긴 값 그대로)
+    void pageReady(const QString &ip, const QString &function, qint64 sinceMs, const QVector<LogEntry> &entries);
+    void finished(const QString &ip, const QString &function, HistoryFetcher::Result result);
+
+private:
+    explicit HistoryFetcher(QObject *parent = nullptr);
+
+    struct Job {
+        quint64 id;
+        CameraInfo camera;
+        QString function;
+        qint64 sinceMs;        // 동기화 시작 기준 (중복 판정용)
+        QString pageSince;     // 다음 페이지 커서 (서버 시각 문자열)
+        int pages = 0;
+    };
+
+    void dispatch();
+    void startPage(Job job);
+    void onPageParsed(Job job, const QVector<LogEntry> &entries, const QString &lastTimestamp, bool hasMore,
+                      Result result);
+
+    struct Active {
+        QString ip;
+        quint64 requestId;     // NetworkClient 요청 (파싱 중이면 0)
+    };
+
+    std::deque<Job> queue;
+    QHash<quint64, Active> active;       // 진행 중 Job ID → 상태 (취소되면 빠짐 → 늦게 온 결과는 버림)
+    quint64 nextId = 1;
+    int maxConcurrent = 3;
+    int pageSize = 500;
+};
+
+#endif // HISTORYFETCHER_H
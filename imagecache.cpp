@@ -0,0 +1,337 @@
+#include "imagecache.h"
+#include "imagedecoder.h"
+
+#include <QNetworkReply>
+#include <QCryptographicHash>
+#include <QStandardPaths>
+#include <QSaveFile>
+#include <QFile>
+#include <QDir>
+#include <QThreadPool>
+#include <QTimer>
+#include <QUrl>
+#include <QDebug>
+
+namespace {
+constexpr qint64 kMemoryBudgetBytes = 96 * 1024 * 1024;
+constexpr qint64 kDiskBudgetBytes = 512LL * 1024 * 1024;
+
+int pixmapCost(const QPixmap &pix)
+{
+    return qMax(1, pix.width() * pix.height() * pix.depth() / 8);
+}
+
+// 작업 스레드에서 호출
+QByteArray readFile(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return QByteArray();
+    return file.readAll();
+}
+
+void writeFile(const QString &path, const QByteArray &bytes)
+{
+    if (bytes.isEmpty()) return;
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) return;
+    file.write(bytes);
+    file.commit();
+}
+}
+
+ImageCache *ImageCache::instance()
+{
+    static ImageCache *cache = new ImageCache();
+    return cache;
+}
+
+ImageCache::ImageCache(QObject *parent)
+    : QObject(parent)
+{
+    memory.setMaxCost(kMemoryBudgetBytes);
+
+    diskDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/images";
+    QDir().mkpath(diskDir);
+    trimDiskCache();
+
+    connect(NetworkClient::instance(), &NetworkClient::hostCancelled, this, &ImageCache::onHostCancelled);
+}
+
+QString ImageCache::memoryKey(const QString &url, const QSize &size)
+{
+    if (!size.isValid()) return url;
+    return QString("%1@%2x%3").arg(url).arg(size.width()).arg(size.height());
+}
+
+QString ImageCache::diskPath(const QString &url) const
+{
+    QByteArray hash = QCryptographicHash::hash(url.toUtf8(), QCryptographicHash::Sha1).toHex();
+    return diskDir + "/" + QString::fromLatin1(hash) + ".img";
+}
+
+QPixmap ImageCache::cached(const QString &url, const QSize &targetSize) const
+{
+    if (QPixmap *pix = memory.object(memoryKey(url, targetSize)))
+        return *pix;
+    return QPixmap();
+}
+
+quint64 ImageCache::request(const QString &url, const QSize &targetSize, QObject *context, Callback callback,
+                            NetworkClient::Priority priority)
+{
+    const quint64 ticket = nextTicket++;
+    const bool hasContext = context != nullptr;
+    QPointer<QObject> ctx(context);
+    countRequest();
+
+    // 1) 메모리 적중
+    QPixmap hit = cached(url, targetSize);
+    if (!hit.isNull()) {
+        ++counters.memoryHits;
+        QTimer::singleShot(0, this, [=]() {
+            if (!hasContext || ctx) callback(hit);
+        });
+        return ticket;
+    }
+
+    ticketUrls.insert(ticket, url);
+    watchContext(context);
+
+    // 2) 이미 같은 URL을 처리 중이면 합류 (더 급한 요청이면 우선순위 상향)
+    auto it = pending.find(url);
+    if (it != pending.end()) {
+        ++counters.coalesced;
+        it->waiters.append({ticket, targetSize, hasContext, ctx, callback});
+        if (priority < it->priority) {
+            it->priority = priority;
+            if (it->jobId) NetworkClient::instance()->setPriority(it->jobId, priority);
+        }
+        return ticket;
+    }
+
+    Pending &entry = pending[url];
+    entry.generation = nextGeneration++;
+    entry.priority = priority;
+    entry.waiters.append({ticket, targetSize, hasContext, ctx, callback});
+
+    // 3) 디스크 조회 → 없으면 다운로드 (onDecoded에서 판단)
+    startDecode(url, QByteArray());
+    return ticket;
+}
+
+void ImageCache::cancel(quint64 ticket)
+{
+    QString url = ticketUrls.take(ticket);
+    if (url.isEmpty()) return;
+
+    auto it = pending.find(url);
+    if (it == pending.end()) return;
+
+    QVector<Waiter> &waiters = it->waiters;
+    for (int i = 0; i < waiters.size(); ++i) {
+        if (waiters[i].ticket == ticket) {
+            waiters.remove(i);
+            break;
+        }
+    }
+
+    // 기다리는 쪽이 없으면 다운로드 자체를 중단 (디코딩 결과는 세대 번호로 무시)
+    if (waiters.isEmpty()) {
+        quint64 jobId = it->jobId;
+        pending.erase(it);
+        if (jobId) NetworkClient::instance()->cancel(jobId);
+    }
+}
+
+void ImageCache::watchContext(QObject *context)
+{
+    if (!context || watchedContexts.contains(context)) return;
+    watchedContexts.insert(context);
+    connect(context, &QObject::destroyed, this, [this, context]() {
+        watchedContexts.remove(context);
+        cancelContext(context);
+    });
+}
+
+void ImageCache::cancelContext(QObject *context)
+{
+    // 닫힌 다이얼로그 등: 남은 요청 정리 (다른 쪽이 기다리지 않으면 다운로드 중단)
+    QList<quint64> tickets;
+    for (const Pending &entry : std::as_const(pending)) {
+        for (const Waiter &waiter : entry.waiters) {
+            if (waiter.hasContext && (!waiter.context || waiter.context == context))
+                tickets.append(waiter.ticket);
+        }
+    }
+    for (quint64 ticket : tickets)
+        cancel(ticket);
+}
+
+void ImageCache::onHostCancelled(const QString &host)
+{
+    // 삭제된 카메라: 다운로드가 취소됐으므로 기다리던 쪽에는 실패로 알림
+    QStringList urls;
+    for (auto it = pending.constBegin(); it != pending.constEnd(); ++it) {
+        if (it->jobId && QUrl(it.key()).host() == host)
+            urls.append(it.key());
+    }
+    for (const QString &url : urls)
+        failPending(url);
+}
+
+void ImageCache::startDecode(const QString &url, const QByteArray &downloaded)
+{
+    auto it = pending.find(url);
+    if (it == pending.end()) return;
+
+    it->decoding = true;
+    it->jobId = 0;
+
+    QVector<QSize> sizes;
+    for (const Waiter &waiter : std::as_const(it->waiters)) {
+        if (!sizes.contains(waiter.size))
+            sizes.append(waiter.size);
+    }
+
+    const quint64 generation = it->generation;
+    const QString path = diskPath(url);
+
+    ImageDecoder::pool()->start([=]() {
+        QByteArray bytes = downloaded;
+        bool fromDisk = false;
+        if (bytes.isEmpty()) {
+            bytes = readFile(path);
+            fromDisk = !bytes.isEmpty();
+        } else {
+            writeFile(path, bytes);
+        }
+
+        QVector<QImage> images;
+        if (!bytes.isEmpty()) {
+            for (const QSize &size : sizes)
+                images.append(ImageDecoder::decode(bytes, size));
+        }
+
+        QMetaObject::invokeMethod(this, [=]() {
+            onDecoded(url, generation, bytes, fromDisk, sizes, images);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void ImageCache::onDecoded(const QString &url, quint64 generation, const QByteArray &bytes, bool fromDisk,
+                           const QVector<QSize> &sizes, const QVector<QImage> &images)
+{
+    auto it = pending.find(url);
+    if (it == pending.end() || it->generation != generation) return;   // 그 사이 취소됨
+    it->decoding = false;
+
+    if (bytes.isEmpty()) {
+        // 디스크에 없음 → 다운로드
+        ++counters.misses;
+        startDownload(url, it->priority);
+        return;
+    }
+
+    if (fromDisk) {
+        ++counters.diskHits;
+        counters.bytesSaved += bytes.size();
+    }
+
+    // UI 스레드에서는 완성된 QImage → QPixmap 변환만
+    for (int i = 0; i < sizes.size(); ++i) {
+        if (!images[i].isNull()) {
+            QPixmap pix = QPixmap::fromImage(images[i]);
+            memory.insert(memoryKey(url, sizes[i]), new QPixmap(pix), pixmapCost(pix));
+        }
+    }
+
+    QVector<Waiter> remaining;
+    const QVector<Waiter> waiters = it->waiters;
+    for (const Waiter &waiter : waiters) {
+        int idx = sizes.indexOf(waiter.size);
+        if (idx < 0) {
+            remaining.append(waiter);   // 디코딩 중에 다른 크기로 합류한 요청
+            continue;
+        }
+        ticketUrls.remove(waiter.ticket);
+        if (waiter.hasContext && !waiter.context) continue;   // 요청한 쪽이 이미 사라짐
+        waiter.callback(images[idx].isNull() ? QPixmap() : cached(url, waiter.size));
+    }
+
+    // 콜백 안에서 pending이 바뀌었을 수 있으므로 다시 찾음
+    it = pending.find(url);
+    if (it == pending.end() || it->generation != generation) return;
+
+    if (remaining.isEmpty()) {
+        pending.erase(it);
+    } else {
+        it->waiters = remaining;
+        startDecode(url, QByteArray());   // 방금 디스크에 기록됨
+    }
+}
+
+void ImageCache::startDownload(const QString &url, NetworkClient::Priority priority)
+{
+    quint64 jobId = NetworkClient::instance()->get(QNetworkRequest(QUrl(url)), priority, this,
+                                                   [=](QNetworkReply *reply) {
+        auto it = pending.find(url);
+        if (it == pending.end()) return;   // 취소됨
+
+        if (reply->error() != QNetworkReply::NoError) {
+            qWarning() << "[이미지 캐시] 다운로드 실패:" << url << reply->errorString();
+            ++counters.failures;
+            failPending(url);
+            return;
+        }
+
+        QByteArray bytes = reply->readAll();
+        counters.bytesDownloaded += bytes.size();
+        startDecode(url, bytes);   // 디스크 기록 + 디코딩 (작업 스레드)
+    });
+    pending[url].jobId = jobId;
+}
+
+void ImageCache::failPending(const QString &url)
+{
+    auto it = pending.find(url);
+    if (it == pending.end()) return;
+    QVector<Waiter> waiters = it->waiters;
+    pending.erase(it);
+
+    for (const Waiter &waiter : waiters) {
+        ticketUrls.remove(waiter.ticket);
+        if (waiter.hasContext && !waiter.context) continue;
+        waiter.callback(QPixmap());
+    }
+}
+
+void ImageCache::trimDiskCache() const
+{
+    // 최근 파일부터 합산해서 한도를 넘는 오래된 파일 삭제
+    QDir dir(diskDir);
+    const QFileInfoList files = dir.entryInfoList(QDir::Files, QDir::Time);
+    qint64 total = 0;
+    for (const QFileInfo &info : files) {
+        total += info.size();
+        if (total > kDiskBudgetBytes)
+            QFile::remove(info.absoluteFilePath());
+    }
+}
+
+void ImageCache::countRequest()
+{
+    if (++requestCount % 200 == 0)
+        qDebug().noquote() << "[이미지 캐시]" << statsSummary();
+}
+
+QString ImageCache::statsSummary() const
+{
+    return QString("메모리 적중 %1 | 디스크 적중 %2 | 다운로드 %3 | 병합 %4 | 실패 %5 | 받은 용량 %6 KB | 절약 %7 KB")
+        .arg(counters.memoryHits)
+        .arg(counters.diskHits)
+        .arg(counters.misses)
+        .arg(counters.coalesced)
+        .arg(counters.failures)
+        .arg(counters.bytesDownloaded / 1024)
+        .arg(counters.bytesSaved / 1024);
+}
@@ -0,0 +1,104 @@
+#ifndef IMAGECACHE_H
+#define IMAGECACHE_H
+
+#include <QObject>
+#include <QCache>
+#include <QHash>
+#include <QImage>
+#include <QPixmap>
+#include <QPointer>
+#include <QSize>
+#include <QSet>
+#include <QVector>
+
+#include "networkclient.h"
+
+#include <functional>
+
+// ✅ 이벤트 스냅샷 공용 이미지 캐시 (앱 전체 1개)
+//    1차: 디코딩된 QPixmap 메모리 LRU (바이트 한도)
+//    2차: URL 기준 디스크 캐시 (원본 JPEG 바이트)
+//    같은 URL 동시 요청은 다운로드 1회로 병합
+//    디스크 읽기/쓰기와 디코딩은 ImageDecoder 스레드 풀에서 수행
+class ImageCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Stats {
+        quint64 memoryHits = 0;
+        quint64 diskHits = 0;
+        quint64 misses = 0;          // 실제 다운로드
+        quint64 coalesced = 0;       // 진행 중 다운로드에 합류
+        quint64 failures = 0;
+        quint64 bytesDownloaded = 0;
+        quint64 bytesSaved = 0;      // 디스크 캐시 덕분에 받지 않은 바이트
+    };
+
+    using Callback = std::function<void(const QPixmap &pixmap)>;
+
+    static ImageCache *instance();
+
+    // targetSize가 유효하면 비율 유지 축소본을 캐시/반환, 아니면 원본
+    // 콜백은 항상 이벤트 루프를 거쳐 비동기로 호출 (실패 시 null QPixmap)
+    // context가 소멸되면 해당 요청은 자동 취소
+    quint64 request(const QString &url, const QSize &targetSize, QObject *context, Callback callback,
+                    NetworkClient::Priority priority = NetworkClient::High);
+    void cancel(quint64 ticket);
+
+    QPixmap cached(const QString &url, const QSize &targetSize = QSize()) const;
+
+    // 디스크 캐시 파일 경로 (원본 바이트, 아직 없거나 정리로 지워졌을 수 있음)
+    //    diskDir은 생성 후 바뀌지 않음 → 어느 스레드에서나 호출 가능 (내보내기 작업 스레드)
+    QString diskPath(const QString &url) const;
+    Stats stats() const { return counters; }
+    QString statsSummary() const;
+
+private:
+    explicit ImageCache(QObject *parent = nullptr);
+
+    struct Waiter {
+        quint64 ticket;
+        QSize size;
+        bool hasContext;
+        QPointer<QObject> context;
+        Callback callback;
+    };
+
+    struct Pending {
+        quint64 generation = 0;     // 취소 후 같은 URL 재요청과 구분
+        quint64 jobId = 0;          // NetworkClient 요청 (다운로드 중일 때만)
+        NetworkClient::Priority priority = NetworkClient::Low;
+        QVector<Waiter> waiters;
+        bool decoding = false;      // 작업 스레드에서 디스크 조회/디코딩 중
+    };
+
+    static QString memoryKey(const QString &url, const QSize &size);
+    void trimDiskCache() const;
+
+    // 디스크 조회 + 디코딩은 작업 스레드, 결과 반영은 UI 스레드
+    void startDecode(const QString &url, const QByteArray &downloaded);
+    void onDecoded(const QString &url, quint64 generation, const QByteArray &bytes, bool fromDisk,
+                   const QVector<QSize> &sizes, const QVector<QImage> &images);
+    void startDownload(const QString &url, NetworkClient::Priority priority);
+    void failPending(const QString &url);
+
+    void watchContext(QObject *context);
+    void cancelContext(QObject *context);
+    void onHostCancelled(const QString &host);
+    void countRequest();
+
+    QCache<QString, QPixmap> memory;     // 비용 = 바이트 수
+    QHash<QString, Pending> pending;     // URL → 진행 중 요청
+    QHash<quint64, QString> ticketUrls;  // 취소용
+    quint64 nextTicket = 1;
+    quint64 nextGeneration = 1;
+
+    QSet<QObject*> watchedContexts;
+
+    QString diskDir;
+    Stats counters;
+    quint64 requestCount = 0;
+};
+
+#endif // IMAGECACHE_H
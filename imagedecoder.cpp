@@ -0,0 +1,47 @@
+#include "imagedecoder.h"
+
+#include <QBuffer>
+#include <QImageReader>
+#include <QThread>
+#include <QThreadPool>
+
+QImage ImageDecoder::decode(const QByteArray &bytes, const QSize &targetSize)
+{
+    if (bytes.isEmpty()) return QImage();
+
+    QBuffer buffer;
+    buffer.setData(bytes);
+    buffer.open(QIODevice::ReadOnly);
+
+    QImageReader reader(&buffer);
+    reader.setAutoTransform(true);
+
+    if (targetSize.isValid()) {
+        QSize original = reader.size();
+        if (original.isValid() &&
+            (original.width() > targetSize.width() || original.height() > targetSize.height())) {
+            reader.setScaledSize(original.scaled(targetSize, Qt::KeepAspectRatio));
+            reader.setQuality(100);   // 축소 시 부드러운 보간 사용
+        }
+    }
+
+    QImage image = reader.read();
+    if (image.isNull()) return image;
+
+    // UI 스레드에서 바로 그릴 수 있는 형식으로 변환까지 끝내 둠
+    if (image.format() != QImage::Format_RGB32 && image.format() != QImage::Format_ARGB32_Premultiplied)
+        image = image.convertToFormat(image.hasAlphaChannel() ? QImage::Format_ARGB32_Premultiplied
+                                                              : QImage::Format_RGB32);
+    return image;
+}
+
+QThreadPool *ImageDecoder::pool()
+{
+    // UI 스레드 몫 1개는 남겨 둠
+    static QThreadPool *decodePool = []() {
+        QThreadPool *p = new QThreadPool();
+        p->setMaxThreadCount(qMax(2, QThread::idealThreadCount() - 1));
+        return p;
+    }();
+    return decodePool;
+}
@@ -0,0 +1,19 @@
+#ifndef IMAGEDECODER_H
+#define IMAGEDECODER_H
+
+#include <QByteArray>
+#include <QImage>
+#include <QSize>
+
+class QThreadPool;
+
+// ✅ 스냅샷 디코딩 (작업 스레드 전용)
+//    썸네일은 QImageReader::setScaledSize로 디코딩 단계에서 바로 축소
+//    (JPEG은 DCT 단계 축소 → 원본 해상도 전체 디코딩 없음)
+class ImageDecoder {
+public:
+    static QImage decode(const QByteArray &bytes, const QSize &targetSize = QSize());
+    static QThreadPool *pool();
+};
+
+#endif // IMAGEDECODER_H
@@ -0,0 +1,85 @@
+#include "imagepreviewdialog.h"
+#include "enhancementcontroller.h"
+#include "imagecache.h"
+
+#include <QVBoxLayout>
+
+ImagePreviewDialog::ImagePreviewDialog(const QString &imageUrl, QWidget *parent)
+    : QDialog(parent)
+{
+    setWindowTitle("이미지 미리보기");
+    setStyleSheet("background-color: black;");
+    resize(320, 240);
+
+    QVBoxLayout *popupLayout = new QVBoxLayout(this);
+
+    imgLabel = new QLabel("불러오는 중...");
+    imgLabel->setAlignment(Qt::AlignCenter);
+    imgLabel->setStyleSheet("color: white;");
+    popupLayout->addWidget(imgLabel);
+
+    // 🔹 샤프닝 슬라이더
+    sharpLabel = new QLabel("샤프닝: 0");
+    sharpLabel->setStyleSheet("color: #f37321; font-size: 11px;");
+    sharpLabel->setAlignment(Qt::AlignCenter);
+    popupLayout->addWidget(sharpLabel);
+
+    sharpSlider = new QSlider(Qt::Horizontal);
+    sharpSlider->setRange(-100, 100);
+    sharpSlider->setValue(0);
+    sharpSlider->setStyleSheet("QSlider { background: #1e1e1e; }");
+    popupLayout->addWidget(sharpSlider);
+
+    // 🔹 대비 슬라이더
+    contrastLabel = new QLabel("대비: 0");
+    contrastLabel->setStyleSheet("color: #f37321; font-size: 11px;");
+    contrastLabel->setAlignment(Qt::AlignCenter);
+    popupLayout->addWidget(contrastLabel);
+
+    contrastSlider = new QSlider(Qt::Horizontal);
+    contrastSlider->setRange(-100, 100);
+    contrastSlider->setValue(0);
+    contrastSlider->setStyleSheet("QSlider { background: #1e1e1e; }");
+    popupLayout->addWidget(contrastSlider);
+
+    // ✅ 보정은 작업 스레드에서 (드래그 중 320x240, 놓으면 원본 해상도)
+    enhancer = new EnhancementController(QSize(320, 240), this);
+    connect(enhancer, &EnhancementController::rendered, this, [=](const QImage &display, bool) {
+        imgLabel->setPixmap(QPixmap::fromImage(display));
+    });
+
+    connect(sharpSlider, &QSlider::valueChanged, this, &ImagePreviewDialog::applyEnhancements);
+    connect(contrastSlider, &QSlider::valueChanged, this, &ImagePreviewDialog::applyEnhancements);
+    connect(sharpSlider, &QSlider::sliderReleased, this, &ImagePreviewDialog::applyEnhancements);
+    connect(contrastSlider, &QSlider::sliderReleased, this, &ImagePreviewDialog::applyEnhancements);
+
+    // ✅ 공용 이미지 캐시에서 요청 (썸네일 로딩 때 받은 파일 재사용)
+    //    표시용 축소본을 먼저 띄우고, 보정용 원본이 오면 교체
+    ImageCache::instance()->request(imageUrl, QSize(320, 240), this, [=](const QPixmap &pix) {
+        if (!pix.isNull() && !enhancer->hasImage())
+            imgLabel->setPixmap(pix);
+    });
+    ImageCache::instance()->request(imageUrl, QSize(), this, [=](const QPixmap &pix) {
+        if (pix.isNull()) {
+            imgLabel->setText("❌ 이미지 없음");
+            return;
+        }
+        enhancer->setImage(pix.toImage());
+        applyEnhancements();
+    });
+}
+
+void ImagePreviewDialog::applyEnhancements()
+{
+    int sharpVal = sharpSlider->value();
+    int contrastVal = contrastSlider->value();
+
+    sharpLabel->setText(QString("샤프닝: %1").arg(sharpVal));
+    contrastLabel->setText(QString("대비: %1").arg(contrastVal));
+
+    // 드래그 중에는 미리보기 해상도, 그 외(놓음/키보드/휠)는 원본 해상도
+    if (sharpSlider->isSliderDown() || contrastSlider->isSliderDown())
+        enhancer->requestPreview(sharpVal, contrastVal);
+    else
+        enhancer->requestFull(sharpVal, contrastVal);
+}
@@ -0,0 +1,31 @@
+#ifndef IMAGEPREVIEWDIALOG_H
+#define IMAGEPREVIEWDIALOG_H
+
+#include <QDialog>
+#include <QLabel>
+#include <QSlider>
+#include <QPixmap>
+
+class EnhancementController;
+
+// ✅ 실시간 로그 썸네일 클릭 시 뜨는 이미지 미리보기 (샤프닝/대비 슬라이더 포함)
+class ImagePreviewDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit ImagePreviewDialog(const QString &imageUrl, QWidget *parent = nullptr);
+
+private:
+    void applyEnhancements();
+
+    QLabel *imgLabel;
+    QLabel *sharpLabel;
+    QLabel *contrastLabel;
+    QSlider *sharpSlider;
+    QSlider *contrastSlider;
+
+    EnhancementController *enhancer;   // ✅ 원본 보관 + 작업 스레드 보정
+};
+
+#endif // IMAGEPREVIEWDIALOG_H
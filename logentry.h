@@ -9,6 +9,7 @@ struct LogEntry {
     QString event;
     QString timestamp;
     QString imageUrl;
+    QString details;     // 부가 정보 (인원수, 신뢰도 등, 없으면 빈 문자열)
 };
 
 #endif // LOGENTRY_H
@@ -1,5 +1,5 @@
 #include "loghistorydialog.h"
-#include "imageenhancer.h"
+#include "imagecache.h"
 
 #include <QVBoxLayout>
 #include <QLabel>
@@ -7,17 +7,20 @@
 #include <QHeaderView>
 #include <QHBoxLayout>
 #include <QPixmap>
-#include <QNetworkReply>
-#include <QUrl>
 #include <QFontDatabase>
-#include <QTabWidget>
+#include <QTabBar>
 #include <QCheckBox>
-#include <QTableWidgetItem>
 #include <QTimer>
 #include <QMouseEvent>
 #include <QSlider>
-
-LogHistoryDialog::LogHistoryDialog(const QVector<LogEntry> &logs, QWidget *parent)
+#include <QSignalBlocker>
+#include <QDateTime>
+#include <QLocale>
+#include <QSet>
+#include <QFileDialog>
+#include <QMessageBox>
+
+LogHistoryDialog::LogHistoryDialog(const EventRing &logs, QWidget *parent)
     : QDialog(parent), allLogs(logs)
 {
     // ✅ Frameless 적용
@@ -39,15 +42,11 @@ LogHistoryDialog::LogHistoryDialog(const QVector<LogEntry> &logs, QWidget *paren
             color: white;
             border-bottom: 1px solid #555;
         }
-        QTableWidget {
+        QTableView {
             background-color: #1e1e1e;
             color: white;
             gridline-color: #444;
         }
-        QTabWidget::pane {
-            border: none;
-            background-color: #2b2b2b;
-        }
         QTabBar::tab {
             background-color: #2b2b2b;
             color: white;
@@ -69,6 +68,18 @@ LogHistoryDialog::LogHistoryDialog(const QVector<LogEntry> &logs, QWidget *paren
 
     setupUI();
     populateTabs();
+
+    // ✅ 열려 있는 동안 들어온 이벤트: 표는 모델이 바뀐 부분만 반영, 탭/타임라인은 모아서 갱신
+    liveTimer = new QTimer(this);
+    liveTimer->setSingleShot(true);
+    liveTimer->setInterval(500);
+    connect(liveTimer, &QTimer::timeout, this, [=]() {
+        addNewCameraTabs();
+        refreshTimeline();
+    });
+    connect(&allLogs, &EventRing::changed, this, [=]() {
+        if (!liveTimer->isActive()) liveTimer->start();
+    });
 }
 
 void LogHistoryDialog::setupUI()
@@ -109,6 +120,7 @@ void LogHistoryDialog::setupUI()
             color: #f37321;
         }
     )");
+    closeBtn->setAutoDefault(false);   // 검색창에서 Enter를 눌러도 닫히지 않게
     connect(closeBtn, &QPushButton::clicked, this, &QDialog::accept);
 
     topLayout->addWidget(title);
@@ -160,17 +172,177 @@ void LogHistoryDialog::setupUI()
     filterWidget->setStyleSheet("background-color: transparent;");
     filterWidget->setFixedHeight(460);
 
-    auto delayedApplyFilter = [=]() {
-        QTimer::singleShot(0, this, [=]() { applyFilter(); });
-    };
+    // ✅ 체크박스 하나를 눌러도 동기화로 여러 신호가 나옴 → 다음 이벤트 루프에서 한 번만 적용
+    filterTimer = new QTimer(this);
+    filterTimer->setSingleShot(true);
+    filterTimer->setInterval(0);
+    connect(filterTimer, &QTimer::timeout, this, &LogHistoryDialog::applyFilter);
+
+    // ✅ 탭은 머리표만, 테이블은 하나 (탭 전환 = 모델 필터 변경)
+    tabBar = new QTabBar(this);
+    tabBar->setExpanding(false);
+    tabBar->setDrawBase(false);
+    connect(tabBar, &QTabBar::currentChanged, this, &LogHistoryDialog::scheduleFilter);
+
+    historyModel = new EventHistoryModel(allLogs, this);
+
+    tableView = new QTableView(this);
+    tableView->setModel(historyModel);
+    tableView->horizontalHeader()->setSectionResizeMode(EventHistoryModel::TimeColumn, QHeaderView::Fixed);
+    tableView->setColumnWidth(EventHistoryModel::TimeColumn, 200);
+    tableView->horizontalHeader()->setSectionResizeMode(EventHistoryModel::CameraColumn, QHeaderView::Fixed);
+    tableView->setColumnWidth(EventHistoryModel::CameraColumn, 100);
+    tableView->horizontalHeader()->setSectionResizeMode(EventHistoryModel::FunctionColumn, QHeaderView::Fixed);
+    tableView->setColumnWidth(EventHistoryModel::FunctionColumn, 100);
+    tableView->horizontalHeader()->setSectionResizeMode(EventHistoryModel::EventColumn, QHeaderView::Stretch);
+
+    // 행 높이 고정 → 행 수와 무관하게 스크롤/배치 비용 일정
+    tableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    tableView->verticalHeader()->setDefaultSectionSize(24);
+
+    tableView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    tableView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    tableView->setSelectionMode(QAbstractItemView::SingleSelection);
+    tableView->setFont(QFont(gfontR, 8));   // 셀마다 지정하지 않고 뷰 전체에 한 번
+
+    tableView->setShowGrid(true);
+    tableView->setStyleSheet(R"(
+        QTableView {
+            background-color: #1e1e1e;
+            color: white;
+            gridline-color: #666;        /* 테두리 색상 */
+            border: 1px solid #888;      /* 전체 테두리 */
+        }
+        QTableView::item {
+            border: none;      /* 셀 테두리 */
+            padding: 4px;
+        }
+        QHeaderView::section {
+            background-color: #2b2b2b;
+            color: white;
+            border: none;      /* 헤더 테두리 */
+        }
+    )");
+    connect(tableView, &QTableView::clicked, this, &LogHistoryDialog::handleRowClick);
+
+    // ✅ 검색창: 이벤트 문구/카메라/기능/부가 정보 (예: "헬멧", "조끼", "침입 3명")
+    searchEdit = new QLineEdit();
+    searchEdit->setPlaceholderText("🔍 검색 (예: 헬멧, 침입 3명)");
+    searchEdit->setClearButtonEnabled(true);
+    searchEdit->setFixedWidth(240);
+    searchEdit->setFont(QFont(gfontR, 10));
+    searchEdit->setStyleSheet(R"(
+        QLineEdit {
+            background-color: #2b2b2b;
+            color: white;
+            border: 1px solid #555;
+            border-radius: 4px;
+            padding: 3px 6px;
+        }
+        QLineEdit:focus {
+            border: 1px solid #f37321;
+        }
+    )");
 
-    connect(totalCheck,    &QCheckBox::checkStateChanged, this, delayedApplyFilter);
-    connect(ppeCheck,      &QCheckBox::checkStateChanged, this, delayedApplyFilter);
-    connect(trespassCheck, &QCheckBox::checkStateChanged, this, delayedApplyFilter);
-    connect(fallCheck,     &QCheckBox::checkStateChanged, this, delayedApplyFilter);
+    searchTimer = new QTimer(this);
+    searchTimer->setSingleShot(true);
+    searchTimer->setInterval(150);
+    connect(searchTimer, &QTimer::timeout, this, &LogHistoryDialog::scheduleFilter);
+    connect(searchEdit, &QLineEdit::textChanged, searchTimer, qOverload<>(&QTimer::start));
+    connect(searchEdit, &QLineEdit::returnPressed, this, [=]() {
+        searchTimer->stop();
+        scheduleFilter();
+    });
 
-    tabWidget = new QTabWidget(this);
-    connect(tabWidget, &QTabWidget::currentChanged, this, &LogHistoryDialog::applyFilter);
+    // ✅ 결과 건수 (작업 스레드 필터링 중에는 "검색 중")
+    resultLabel = new QLabel();
+    resultLabel->setStyleSheet("color: #aaaaaa; font-size: 11px;");
+    resultLabel->setFont(QFont(gfontR, 9));
+    resultLabel->setToolTip("메모리에 보관 중인 이벤트 기준 (최근 30일, 최대 20만 건)");
+    auto updateResultLabel = [=]() {
+        const QString count = QLocale().toString(historyModel->rowCount());
+        resultLabel->setText(historyModel->isFiltering() ? QString("검색 중… %1건").arg(count)
+                                                         : QString("%1건").arg(count));
+    };
+    connect(historyModel, &EventHistoryModel::filteringChanged, this, updateResultLabel);
+    connect(historyModel, &QAbstractItemModel::rowsInserted, this, updateResultLabel);
+    connect(historyModel, &QAbstractItemModel::rowsRemoved, this, updateResultLabel);   // 실시간 반영으로 위/아래 행 제거
+    connect(historyModel, &QAbstractItemModel::modelReset, this, updateResultLabel);
+
+    QHBoxLayout *tabRow = new QHBoxLayout();
+    tabRow->setContentsMargins(0, 0, 0, 4);
+    tabRow->addWidget(tabBar);
+    tabRow->addStretch();
+    tabRow->addWidget(resultLabel);
+    tabRow->addSpacing(8);
+    tabRow->addWidget(searchEdit);
+
+    // ✅ 내보내기: 지금 보이는 조건(탭 + 기능 + 검색어) 그대로
+    exportButton = new QPushButton("내보내기");
+    exportButton->setFont(QFont(gfontR, 10));
+    exportButton->setAutoDefault(false);
+    exportButton->setStyleSheet(R"(
+        QPushButton {
+            background-color: #2b2b2b;
+            color: white;
+            border: 1px solid #555;
+            border-radius: 4px;
+            padding: 3px 10px;
+        }
+        QPushButton:hover {
+            border: 1px solid #f37321;
+        }
+        QPushButton:disabled {
+            color: #777;
+        }
+    )");
+    connect(exportButton, &QPushButton::clicked, this, &LogHistoryDialog::startExport);
+    tabRow->addSpacing(6);
+    tabRow->addWidget(exportButton);
+
+    exporter = new EventExporter(this);
+    connect(exporter, &EventExporter::progress, this, [=](qint64 rows, qint64 expectedRows, int imagesDone, int imagesTotal) {
+        if (!exportProgress) return;
+        QString text = QString("행 %1").arg(QLocale().toString(rows));
+        if (expectedRows >= 0) {
+            exportProgress->setRange(0, 1000);
+            exportProgress->setValue(expectedRows > 0 ? int(qMin<qint64>(rows, expectedRows) * 1000 / expectedRows) : 1000);
+            text += QString(" / %1").arg(QLocale().toString(expectedRows));
+        }
+        if (imagesTotal > 0)
+            text += QString("\n이미지 %1 / %2").arg(imagesDone).arg(imagesTotal);
+        exportProgress->setLabelText(text);
+    });
+    connect(exporter, &EventExporter::finished, this, [=](bool ok, const QString &message) {
+        bool cancelled = false;
+        if (exportProgress) {
+            cancelled = exportProgress->wasCanceled();
+            exportProgress->deleteLater();
+            exportProgress = nullptr;
+        }
+        exportButton->setEnabled(true);
+        if (cancelled) return;   // 사용자가 취소: 결과 파일 없음, 알림 불필요
+        if (ok)
+            QMessageBox::information(this, "내보내기 완료", message);
+        else
+            QMessageBox::warning(this, "내보내기 실패", message);
+    });
+
+    QWidget *tableContainer = new QWidget();
+    QVBoxLayout *tableLayout = new QVBoxLayout(tableContainer);
+    tableLayout->setContentsMargins(0, 0, 0, 0);
+    tableLayout->setSpacing(0);
+    tableLayout->addLayout(tabRow);
+    tableLayout->addWidget(tableView);
+
+    // ✅ 밀도 타임라인: 클릭하면 그 시간대로 이동
+    timeline = new TimelineStrip();
+    connect(timeline, &TimelineStrip::binClicked, this, [=](qint64, qint64 toMs) {
+        jumpToTime(toMs);   // 칸 시작이 아니라 끝 기준 → 클릭한 칸 안의 가장 최근 행
+    });
+    connect(timeline, &TimelineStrip::resized, this, &LogHistoryDialog::refreshTimeline);
+    tableLayout->addSpacing(4);
+    tableLayout->addWidget(timeline);
 
     // ✅ 이미지 프리뷰 + 샤프닝 & 대비 슬라이더
     QWidget *previewContainer = new QWidget();
@@ -213,31 +385,34 @@ void LogHistoryDialog::setupUI()
 
     previewLayout->addStretch(1);
 
-    auto applyEnhancements = [=]() {
-        if (!originalPreviewPix.isNull()) {
-            int sharpVal = sharpSlider->value();
-            int contrastVal = contrastSlider->value();
+    // ✅ 보정은 작업 스레드에서 (드래그 중 320x240, 놓으면 원본 해상도)
+    enhancer = new EnhancementController(QSize(320, 240), this);
+    connect(enhancer, &EnhancementController::rendered, this, [=](const QImage &display, bool) {
+        imagePreviewLabel->setPixmap(QPixmap::fromImage(display));
+    });
 
-            QPixmap processed = ImageEnhancer::enhanceSharpness(originalPreviewPix, sharpVal);
-            processed = ImageEnhancer::enhanceCLAHE(processed, contrastVal);
+    auto applyEnhancements = [=]() {
+        int sharpVal = sharpSlider->value();
+        int contrastVal = contrastSlider->value();
 
-            sharpLabel->setText(QString("샤프닝: %1").arg(sharpVal));
-            contrastLabel->setText(QString("대비: %1").arg(contrastVal));
+        sharpLabel->setText(QString("샤프닝: %1").arg(sharpVal));
+        contrastLabel->setText(QString("대비: %1").arg(contrastVal));
 
-            imagePreviewLabel->setPixmap(processed.scaled(320, 240,
-                                                          Qt::KeepAspectRatio,
-                                                          Qt::SmoothTransformation));
-        }
+        if (!enhancer->hasImage()) return;
+        if (sharpSlider->isSliderDown() || contrastSlider->isSliderDown())
+            enhancer->requestPreview(sharpVal, contrastVal);
+        else
+            enhancer->requestFull(sharpVal, contrastVal);
     };
 
     connect(sharpSlider, &QSlider::valueChanged, this, applyEnhancements);
     connect(contrastSlider, &QSlider::valueChanged, this, applyEnhancements);
-
-    previewManager = new QNetworkAccessManager(this);
+    connect(sharpSlider, &QSlider::sliderReleased, this, applyEnhancements);
+    connect(contrastSlider, &QSlider::sliderReleased, this, applyEnhancements);
 
     QHBoxLayout *contentLayout = new QHBoxLayout();
     contentLayout->addWidget(filterWidget, 0);
-    contentLayout->addWidget(tabWidget, 3);
+    contentLayout->addWidget(tableContainer, 3);
     contentLayout->addWidget(previewContainer, 1);
 
     outerLayout->addLayout(contentLayout);
@@ -249,7 +424,7 @@ void LogHistoryDialog::setupUI()
             trespassCheck->blockSignals(true); trespassCheck->setChecked(false); trespassCheck->blockSignals(false);
             fallCheck->blockSignals(true); fallCheck->setChecked(false); fallCheck->blockSignals(false);
         }
-        applyFilter();
+        scheduleFilter();
     });
 
     auto updateTotalState = [=]() {
@@ -272,7 +447,7 @@ void LogHistoryDialog::setupUI()
             totalCheck->setChecked(false);
             totalCheck->blockSignals(false);
         }
-        applyFilter();
+        scheduleFilter();
     };
 
     connect(ppeCheck,      &QCheckBox::checkStateChanged, this, updateTotalState);
@@ -302,141 +477,184 @@ void LogHistoryDialog::mouseReleaseEvent(QMouseEvent *event) {
 
 void LogHistoryDialog::populateTabs()
 {
-    tabWidget->clear();
-
-    QStringList cameraNames = {"전체"};
-    for (const LogEntry &entry : allLogs) {
-        if (!cameraNames.contains(entry.cameraName))
-            cameraNames.append(entry.cameraName);
+    const QSignalBlocker blocker(tabBar);
+    while (tabBar->count() > 0)
+        tabBar->removeTab(0);
+
+    // 카메라 ID 기준 (0 = 전체), 카메라 색인에서 바로 (최근 이벤트 순)
+    QVector<quint32> cameraIds = {0};
+    cameraIds += allLogs.cameraIds();
+
+    for (quint32 cameraId : cameraIds) {
+        const QString name = cameraId == 0 ? QString("전체") : EventStrings::text(cameraId);
+        const int index = tabBar->addTab(name);
+        tabBar->setTabData(index, cameraId);
     }
+    tabBar->setCurrentIndex(0);
 
-    for (const QString &name : cameraNames) {
-        QTableWidget *table = new QTableWidget();
-        table->setColumnCount(5);
-        table->setHorizontalHeaderLabels({"Time", "Camera", "Function", "Event", "ImageURL"});
-        table->setColumnHidden(4, true);
-        table->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Fixed);
-        table->setColumnWidth(0, 200);
-        table->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Fixed);
-        table->setColumnWidth(1, 100);
-        table->horizontalHeader()->setSectionResizeMode(2, QHeaderView::Fixed);
-        table->setColumnWidth(2, 100);
-        table->horizontalHeader()->setSectionResizeMode(3, QHeaderView::Stretch);
-
-        table->setEditTriggers(QAbstractItemView::NoEditTriggers);
-        table->setSelectionBehavior(QAbstractItemView::SelectRows);
-        table->setSelectionMode(QAbstractItemView::SingleSelection);
-
-        table->setShowGrid(true);
-        table->setStyleSheet(R"(
-            QTableWidget {
-                background-color: #1e1e1e;
-                color: white;
-                gridline-color: #666;        /* 테두리 색상 */
-                border: 1px solid #888;      /* 전체 테두리 */
-            }
-            QTableWidget::item {
-                border: none;      /* 셀 테두리 */
-                padding: 4px;
-            }
-            QHeaderView::section {
-                background-color: #2b2b2b;
-                color: white;
-                border: none;      /* 헤더 테두리 */
-            }
-        )");
-
-        connect(table, &QTableWidget::cellClicked, this, &LogHistoryDialog::handleRowClick);
-        tabWidget->addTab(table, name);
+    applyFilter();
+}
+
+void LogHistoryDialog::addNewCameraTabs()
+{
+    QSet<quint32> shown;
+    for (int i = 0; i < tabBar->count(); ++i)
+        shown.insert(tabBar->tabData(i).toUInt());
+
+    // 새 카메라는 뒤에 붙임 (기존 탭 순서와 선택은 그대로)
+    for (quint32 cameraId : allLogs.cameraIds()) {
+        if (shown.contains(cameraId)) continue;
+        const int index = tabBar->addTab(EventStrings::text(cameraId));
+        tabBar->setTabData(index, cameraId);
     }
+}
 
-    applyFilter();
+void LogHistoryDialog::scheduleFilter()
+{
+    filterTimer->start();
 }
 
 void LogHistoryDialog::applyFilter()
 {
-    QString selectedCamera = tabWidget->tabText(tabWidget->currentIndex());
-
     bool showTotal     = totalCheck->isChecked();
     bool showPPE       = ppeCheck->isChecked();
     bool showTrespass  = trespassCheck->isChecked();
     bool showFall      = fallCheck->isChecked();
 
-    QTableWidget *table = qobject_cast<QTableWidget *>(tabWidget->currentWidget());
-    if (!table) return;
+    // 문자열 비교 대신 인터닝된 ID, 필터링은 링의 카메라/기능 색인으로
+    EventQuery query;
+    query.camera = tabBar->tabData(tabBar->currentIndex()).toUInt();
+    if (!showTotal) {
+        QVector<quint32> hidden;
+        if (!showPPE) hidden.append(EventStrings::find("PPE"));
+        if (!showTrespass) hidden.append(EventStrings::find("Trespass"));
+        if (!showFall) hidden.append(EventStrings::find("Fall"));
+
+        // 체크 해제된 기능만 빼고 나머지는 그대로 표시
+        for (quint32 function : allLogs.functionIds()) {
+            if (!hidden.contains(function))
+                query.functions.append(function);
+        }
+        if (query.functions.isEmpty())
+            query.functions.append(0);   // 남는 기능 없음 → 빈 결과
+    }
 
-    int gidR = QFontDatabase::addApplicationFont(":/resources/fonts/05HanwhaGothicR.ttf");
-    QString gfontR = QFontDatabase::applicationFontFamilies(gidR).at(0);
-    QFont tableContentsFont(gfontR, 8);
+    query.text = searchEdit->text();   // 링의 문자열 역색인으로 찾음
 
-    table->setRowCount(0);
-    int row = 0;
+    currentQuery = query;
+    historyModel->setFilter(query);
+    refreshTimeline();
+}
 
-    for (const LogEntry &entry : allLogs) {
-        if (selectedCamera != "전체" && entry.cameraName != selectedCamera)
-            continue;
+void LogHistoryDialog::refreshTimeline()
+{
+    // 보관 중인 가장 오래된 이벤트 ~ 지금 (비어 있으면 최근 1시간)
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    const qint64 toMs = now - now % 60000 + 60000;
+    const qint64 fromMs = allLogs.isEmpty() ? toMs - 3600LL * 1000
+                                            : qMin(allLogs.timeAt(allLogs.firstSeq()), toMs - 3600LL * 1000);
+
+    // 검색어는 집계 대상이 아님 → 카메라/기능 조건만 반영
+    const QVector<int> counts = allLogs.stats().histogram(currentQuery.camera, currentQuery.functions,
+                                                          fromMs, toMs, timeline->binCount());
+    timeline->setData(fromMs, toMs, counts);
+}
 
-        if (!showTotal) {
-            if (entry.function == "PPE" && !showPPE) continue;
-            if (entry.function == "Trespass" && !showTrespass) continue;
-            if (entry.function == "Fall" && !showFall) continue;
-        }
+void LogHistoryDialog::jumpToTime(qint64 toMs)
+{
+    // 구간 끝 이전의 가장 최근 행 (검색어로 구간이 비었으면 그 이전 가장 가까운 행)
+    const int row = historyModel->rowBefore(toMs);
+    if (row < 0) return;
 
-        table->insertRow(row);
-        auto *item0 = new QTableWidgetItem(entry.timestamp);
-        auto *item1 = new QTableWidgetItem(entry.cameraName);
-        auto *item2 = new QTableWidgetItem(entry.function);
-        auto *item3 = new QTableWidgetItem(entry.event);
-        auto *item4 = new QTableWidgetItem(entry.imageUrl);
-
-        item0->setFont(tableContentsFont);
-        item1->setFont(tableContentsFont);
-        item2->setFont(tableContentsFont);
-        item3->setFont(tableContentsFont);
-        item4->setFont(tableContentsFont);
-
-        table->setItem(row, 0, item0);
-        table->setItem(row, 1, item1);
-        table->setItem(row, 2, item2);
-        table->setItem(row, 3, item3);
-        table->setItem(row, 4, item4);
-
-        ++row;
-    }
+    tableView->scrollTo(historyModel->index(row, EventHistoryModel::TimeColumn), QAbstractItemView::PositionAtTop);
+    tableView->selectRow(row);
 }
 
-void LogHistoryDialog::handleRowClick(int row, int)
+void LogHistoryDialog::handleRowClick(const QModelIndex &index)
 {
-    QTableWidget *table = qobject_cast<QTableWidget *>(sender());
-    if (!table) return;
+    if (!index.isValid()) return;
+
+    QString url = historyModel->imageUrl(index.row()).trimmed();
+
+    // 이전 선택의 요청은 더 이상 필요 없음
+    ImageCache::instance()->cancel(previewTicket);
+    ImageCache::instance()->cancel(originalTicket);
+    previewTicket = 0;
+    originalTicket = 0;
+    previewUrl = url;
+    enhancer->clear();
 
-    QString url = table->item(row, 4)->text().trimmed();
     if (url.isEmpty()) {
         imagePreviewLabel->setText("❌ 이미지 없음");
         imagePreviewLabel->setPixmap(QPixmap());
-        originalPreviewPix = QPixmap();
         return;
     }
 
-    QNetworkRequest req{QUrl(url)};
-    QNetworkReply *reply = previewManager->get(req);
-
-    connect(reply, &QNetworkReply::finished, this, [=]() {
-        QPixmap pix;
-        pix.loadFromData(reply->readAll());
+    // ✅ 공용 이미지 캐시 사용 (같은 행 재클릭 시 재다운로드 없음)
+    //    표시용 320x240은 작업 스레드에서 축소 디코딩된 것을 그대로 사용
+    previewTicket = ImageCache::instance()->request(url, QSize(320, 240), this, [=](const QPixmap &pix) {
+        if (url != previewUrl) return;
+        previewTicket = 0;
 
         if (!pix.isNull()) {
-            originalPreviewPix = pix;
-            imagePreviewLabel->setPixmap(pix.scaled(320, 240,
-                                                    Qt::KeepAspectRatio,
-                                                    Qt::SmoothTransformation));
+            if (!enhancer->hasImage())
+                imagePreviewLabel->setPixmap(pix);
         } else {
             imagePreviewLabel->setText("❌ 이미지 로드 실패");
             imagePreviewLabel->setPixmap(QPixmap());
-            originalPreviewPix = QPixmap();
         }
+    });
 
-        reply->deleteLater();
+    // 보정(샤프닝/대비)은 원본 해상도 기준
+    originalTicket = ImageCache::instance()->request(url, QSize(), this, [=](const QPixmap &pix) {
+        if (url != previewUrl) return;
+        originalTicket = 0;
+        if (!pix.isNull())
+            enhancer->setImage(pix.toImage());
     });
 }
 
+void LogHistoryDialog::startExport()
+{
+    if (exporter->isRunning()) return;
+
+    const QStringList filters = {
+        "CSV (*.csv)",
+        "JSON Lines (*.jsonl)",
+        "CSV + 이미지 (*.zip)",
+        "JSON Lines + 이미지 (*.zip)",
+    };
+    QString selectedFilter = filters.first();
+    const QString defaultName = QString("event_history_%1.csv")
+                                    .arg(QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss"));
+    QString path = QFileDialog::getSaveFileName(this, "이력 내보내기", defaultName, filters.join(";;"), &selectedFilter);
+    if (path.isEmpty()) return;
+
+    const int choice = qMax(0, filters.indexOf(selectedFilter));
+    EventExporter::Options options;
+    options.format = (choice % 2 == 0) ? EventExporter::Csv : EventExporter::JsonLines;
+    options.withImages = choice >= 2;
+    const QString suffix = options.withImages ? ".zip" : (options.format == EventExporter::Csv ? ".csv" : ".jsonl");
+    if (!path.endsWith(suffix, Qt::CaseInsensitive)) path += suffix;
+    options.path = path;
+
+    // 아직 적용 전인 조건 변경이 있으면 먼저 반영 (보이는 것과 같은 조건으로)
+    if (filterTimer->isActive()) {
+        filterTimer->stop();
+        applyFilter();
+    }
+
+    // 같은 시점의 사본 + 계획 → 내보내는 동안 들어온 이벤트는 포함하지 않음
+    const qint64 expectedRows = historyModel->isFiltering() ? -1 : historyModel->rowCount();
+    if (!exporter->start(allLogs.snapshot(), allLogs.plan(currentQuery), options, expectedRows)) return;
+
+    exportButton->setEnabled(false);
+    exportProgress = new QProgressDialog("내보내는 중…", "취소", 0, 0, this);
+    exportProgress->setWindowTitle("이력 내보내기");
+    exportProgress->setWindowModality(Qt::WindowModal);
+    exportProgress->setMinimumDuration(0);
+    exportProgress->setAutoClose(false);
+    exportProgress->setAutoReset(false);
+    connect(exportProgress, &QProgressDialog::canceled, exporter, &EventExporter::cancel);
+    exportProgress->show();
+}
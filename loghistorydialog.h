@@ -2,24 +2,33 @@
 #define LOGHISTORYDIALOG_H
 
 #include "logentry.h"       // 로그 데이터 구조체
-#include "imageenhancer.h"  // 이미지 향상 기능
+#include "eventring.h"      // 전체 로그 보관소 (복사 없이 참조)
+#include "eventhistorymodel.h"  // 모든 탭이 공유하는 테이블 모델
+#include "timelinestrip.h"  // 집계 기반 밀도 타임라인
+#include "enhancementcontroller.h"  // 이미지 향상 기능 (작업 스레드)
+#include "eventexporter.h"  // 현재 필터 결과 내보내기 (작업 스레드)
 
 #include <QDialog>
-#include <QTableWidget>
+#include <QTableView>
 #include <QVector>
 #include <QLabel>
-#include <QTabWidget>
+#include <QTabBar>
 #include <QCheckBox>
-#include <QNetworkAccessManager>
+#include <QLineEdit>
+#include <QTimer>
 #include <QPixmap>
 #include <QMouseEvent>
+#include <QPushButton>
+#include <QProgressDialog>
 
 class LogHistoryDialog : public QDialog
 {
     Q_OBJECT
 
 public:
-    explicit LogHistoryDialog(const QVector<LogEntry> &logs, QWidget *parent = nullptr);
+    // logs는 다이얼로그보다 오래 살아 있어야 함 (MainWindow 소유)
+    //    복사하지 않음: 표는 공유 사본을 읽고, 열려 있는 동안 들어온 이벤트도 바로 반영
+    explicit LogHistoryDialog(const EventRing &logs, QWidget *parent = nullptr);
 
 protected:
     // ✅ Frameless 드래그 이동 지원
@@ -31,12 +40,35 @@ private:
     // ✅ 내부 UI 구성 및 동작 함수들
     void setupUI();
     void populateTabs();                 // 카메라별 탭 구성
-    void applyFilter();                  // 체크박스 필터링 적용
-    void handleRowClick(int row, int col); // 로그 클릭 시 이미지 표시
+    void addNewCameraTabs();             // 열려 있는 동안 처음 이벤트가 온 카메라 탭 추가
+    void scheduleFilter();               // 같은 틱의 여러 변경을 모아 applyFilter 1회
+    void applyFilter();                  // 탭 + 체크박스 + 검색어 (모델이 작업 스레드에서 실행)
+    void refreshTimeline();              // 현재 탭/기능 기준 밀도 (EventStats 집계에서)
+    void jumpToTime(qint64 toMs);        // 타임라인 칸 끝 이전의 가장 최근 행으로 이동
+    void handleRowClick(const QModelIndex &index); // 로그 클릭 시 이미지 표시
+    void startExport();                  // 저장 위치/형식 선택 → 현재 필터 결과 내보내기
 
     // ✅ 로그 데이터
-    QVector<LogEntry> allLogs;           // 전체 로그 보관
-    QTabWidget *tabWidget;               // 카메라별 탭 위젯
+    const EventRing &allLogs;            // 전체 로그 (최신 순으로 읽음)
+    QTabBar *tabBar;                     // 카메라별 탭 (탭 데이터 = 카메라 ID, 0 = 전체)
+    QTableView *tableView;               // 탭 전환 시 같은 뷰/모델에 필터만 바꿈
+    EventHistoryModel *historyModel;
+
+    // ✅ 타임라인 (현재 필터의 카메라/기능 기준)
+    TimelineStrip *timeline;
+    EventQuery currentQuery;
+
+    // ✅ 검색창 (입력이 멈추면 적용)
+    QLineEdit *searchEdit;
+    QTimer *searchTimer;
+    QTimer *filterTimer;
+    QTimer *liveTimer;                   // 실시간 변경 → 탭/타임라인 갱신 (모아서)
+    QLabel *resultLabel;
+
+    // ✅ 내보내기 (CSV / JSON Lines, 이미지 포함 시 ZIP)
+    QPushButton *exportButton;
+    EventExporter *exporter;
+    QProgressDialog *exportProgress = nullptr;
 
     // ✅ 필터 체크박스
     QCheckBox *totalCheck;
@@ -47,8 +79,10 @@ private:
 
     // ✅ 우측 이미지 미리보기
     QLabel *imagePreviewLabel;
-    QPixmap originalPreviewPix;          // 원본 이미지 저장
-    QNetworkAccessManager *previewManager; // 네트워크 이미지 요청용
+    EnhancementController *enhancer;     // 원본 보관 + 작업 스레드 보정
+    QString previewUrl;                  // 현재 선택된 이미지 URL
+    quint64 previewTicket = 0;           // 이미지 캐시 요청: 표시용 축소본 (선택 변경 시 취소)
+    quint64 originalTicket = 0;          // 이미지 캐시 요청: 보정용 원본
 
     // ✅ Frameless 이동 제어
     bool dragging = false;
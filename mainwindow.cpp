@@ -2,7 +2,12 @@
 #include "camerainfo.h"
 #include "cameraitemwidget.h"
 #include "cameraregistrationdialog.h"
-#include "logitemwidget.h"
+#include "eventlogmodel.h"
+#include "eventlogdelegate.h"
+#include "thumbnailprefetcher.h"
+#include "imagepreviewdialog.h"
+#include "imagecache.h"
+#include "networkclient.h"
 #include "brightnessdialog.h"
 
 #include <QHBoxLayout>
@@ -32,6 +37,8 @@
 #include <QFontDatabase>
 #include <QMouseEvent>
 #include <QToolButton>
+#include <QElapsedTimer>
+#include <QSaveFile>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
@@ -59,13 +66,49 @@ MainWindow::MainWindow(QWidget *parent)
 
     bodyLayout->addWidget(cameraListWrapper, 1);
     bodyLayout->addWidget(videoGridPanel, 3);
-    bodyLayout->addWidget(eventLogScroll, 2);
+    bodyLayout->addWidget(eventLogPanelWrapper, 2);
 
     mainLayout->addLayout(bodyLayout);
     setCentralWidget(central);
 
-    networkManager = new QNetworkAccessManager(this);  // ✅ 초기화
+    // ✅ 지난 실행까지의 이력은 로컬 저장소에서 바로 복원
+    loadStoredLogs();
 
+    // ✅ WebSocket 수신 스레드 시작 (파싱 완료된 이벤트만 UI 스레드로 전달)
+    qRegisterMetaType<CameraEvent>("CameraEvent");
+
+    ingestThread = new QThread(this);
+    ingestWorker = new EventIngestWorker();
+    ingestWorker->moveToThread(ingestThread);
+    connect(ingestThread, &QThread::finished, ingestWorker, &QObject::deleteLater);
+
+    connect(ingestWorker, &EventIngestWorker::eventReady, this, &MainWindow::onCameraEvent);
+    connect(ingestWorker, &EventIngestWorker::cameraConnected, this, &MainWindow::onSocketConnected);
+    connect(ingestWorker, &EventIngestWorker::cameraDisconnected, this, &MainWindow::onSocketDisconnected);
+    connect(ingestWorker, &EventIngestWorker::cameraErrorOccurred, this, &MainWindow::onSocketErrorOccurred);
+
+    ingestThread->start();
+
+    // 카메라 삭제로 요청이 취소되면 핸들러가 불리지 않으므로 동기화 상태도 정리
+    connect(NetworkClient::instance(), &NetworkClient::hostCancelled, this, [=](const QString &host) {
+        historySyncs.remove(host);
+        historyRetryDelay.remove(host);
+    });
+
+    // ✅ 이력은 페이지 단위로 도착 → 페이지마다 정렬 run 1개 (카메라 동기화가 끝나면 병합)
+    connect(HistoryFetcher::instance(), &HistoryFetcher::pageReady, this,
+            [=](const QString &ip, const QString &, qint64 since, const QVector<LogEntry> &entries) {
+        queueHistoryRun(ip, since, entries);
+    });
+    connect(HistoryFetcher::instance(), &HistoryFetcher::finished, this, &MainWindow::onHistoryFinished);
+}
+
+MainWindow::~MainWindow()
+{
+    // 소켓은 수신 스레드에서 생성됐으므로 그 스레드에서 정리
+    QMetaObject::invokeMethod(ingestWorker, &EventIngestWorker::shutdown, Qt::BlockingQueuedConnection);
+    ingestThread->quit();
+    ingestThread->wait();
 }
 
 QPair<int, int> MainWindow::findEmptyVideoSlot() {
@@ -298,7 +341,7 @@ void MainWindow::setupCameraList() {
                 // ✅ 리스트 갱신 및 WebSocket 연결
                 refreshCameraListItems();
                 setupWebSocketConnections();
-                loadInitialLogs();
+                syncCameraHistory(newCam);   // 새 카메라 이력만 (기존 카메라는 다시 받지 않음)
 
             }
         });
@@ -307,15 +350,12 @@ void MainWindow::setupCameraList() {
             // ✅ 여기에 넣으면 됨!
             BrightnessDialog *dialog = new BrightnessDialog(cameraList, this);
             connect(dialog, &BrightnessDialog::brightnessConfirmed, this, [=](const CameraInfo &cam, int value) {
-                if (socketMap.contains(cam.ip)) {
-                    QWebSocket *sock = socketMap[cam.ip];
-                    if (sock->state() == QAbstractSocket::ConnectedState) {
-                        QJsonObject obj;
-                        obj["type"] = "set_brightness";
-                        obj["value"] = value;
-                        sock->sendTextMessage(QJsonDocument(obj).toJson(QJsonDocument::Compact));
-                        qDebug() << "[밝기 전송]" << cam.name << cam.ip << value;
-                    }
+                if (connectedIps.contains(cam.ip)) {
+                    QJsonObject obj;
+                    obj["type"] = "set_brightness";
+                    obj["value"] = value;
+                    sendToCamera(cam.ip, obj);
+                    qDebug() << "[밝기 전송]" << cam.name << cam.ip << value;
                 }
             });
             dialog->exec();
@@ -395,14 +435,14 @@ void MainWindow::refreshCameraListItems() {
                 }
             }
 
-            // 3. WebSocket 정리
-            if (socketMap.contains(target.ip)) {
-                QWebSocket *sock = socketMap[target.ip];
-                sock->close();
-                sock->deleteLater();
-                socketMap.remove(target.ip);
-                qDebug() << "[WebSocket 제거]" << target.ip;
-            }
+            // 3. 해당 카메라로 대기/진행 중인 HTTP 요청 취소
+            NetworkClient::instance()->cancelHost(target.ip);
+
+            // 4. WebSocket 정리 (소켓은 수신 스레드 소유)
+            connectedIps.remove(target.ip);
+            QMetaObject::invokeMethod(ingestWorker, [worker = ingestWorker, ip = target.ip]() {
+                worker->removeCamera(ip);
+            }, Qt::QueuedConnection);
 
             // 리스트 다시 갱신
             refreshCameraListItems();
@@ -499,8 +539,7 @@ void MainWindow::setupEventLog() {
     // 전체 로그 영역 래퍼
     eventLogPanelWrapper = new QWidget();
     eventLogPanelWrapper->setStyleSheet("background-color: #1e1e1e;");
-    eventLogPanelWrapper->setMinimumHeight(0);
-    eventLogPanelWrapper->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Maximum);
+    eventLogPanelWrapper->setFixedWidth(200);
 
     // 👉 외부 레이아웃 (상단 버튼 + 하단 로그)
     QVBoxLayout *outerLayout = new QVBoxLayout(eventLogPanelWrapper);
@@ -531,6 +570,7 @@ void MainWindow::setupEventLog() {
 
     connect(viewAllLogsButton, &QPushButton::clicked, this, [=]() {
         LogHistoryDialog *dialog = new LogHistoryDialog(logEntries, this);  // ✅ 로그 전달
+        dialog->setAttribute(Qt::WA_DeleteOnClose);  // 닫히면 미리보기 요청도 함께 취소
         dialog->exec();
     });
 
@@ -538,31 +578,34 @@ void MainWindow::setupEventLog() {
     headerWidget->setLayout(headerLayout);
     outerLayout->addWidget(headerWidget);        // ✅ 상단에 고정
 
-    // ✅ 로그 항목 영역
-    QWidget *logContainer = new QWidget();
-    eventLogLayout = new QVBoxLayout(logContainer);
-    eventLogLayout->setContentsMargins(0, 0, 0, 0);
-    eventLogLayout->setSpacing(0);
-
-    outerLayout->addWidget(logContainer);
-    outerLayout->addStretch();  // 남는 공간 채움
-
-    // 스크롤 설정
-    eventLogScroll = new QScrollArea();
-    eventLogScroll->setWidgetResizable(true);
-    eventLogScroll->setWidget(eventLogPanelWrapper);
-    eventLogScroll->setFixedWidth(200);
-    eventLogScroll->setAlignment(Qt::AlignTop);
-
-    eventLogScroll->setStyleSheet(R"(
-        QScrollArea {
-            background-color: #1e1e1e;
-            border: none;
-        }
-        QWidget {
-            background-color: #1e1e1e;
-        }
-    )");
+    // ✅ 로그 항목 영역 (모델/뷰: 보이는 행만 그림)
+    eventLogModel = new EventLogModel(maxLiveLogItems, this);
+    EventLogDelegate *delegate = new EventLogDelegate(this);
+
+    eventLogView = new QListView();
+    eventLogView->setModel(eventLogModel);
+    eventLogView->setItemDelegate(delegate);
+    eventLogView->setUniformItemSizes(false);
+    eventLogView->setLayoutMode(QListView::Batched);
+    eventLogView->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    eventLogView->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    eventLogView->setSelectionMode(QAbstractItemView::NoSelection);
+    eventLogView->setFocusPolicy(Qt::NoFocus);
+    eventLogView->setFrameStyle(QFrame::NoFrame);
+    eventLogView->setStyleSheet("QListView { background-color: #1e1e1e; border: none; }");
+
+    connect(delegate, &EventLogDelegate::thumbnailClicked, this, [=](const QString &imageUrl) {
+        ImagePreviewDialog popup(imageUrl, this);
+        popup.exec();
+    });
+
+    outerLayout->addWidget(eventLogView, 1);
+
+    // ✅ 썸네일은 뷰포트 + 앞뒤 3행만 요청, 벗어나거나 밀려나면 취소
+    new ThumbnailPrefetcher(eventLogView, eventLogModel, 3, this);
+
+    logCoalescer = new EventLogCoalescer(maxLiveLogItems, 30, this);
+    connect(logCoalescer, &EventLogCoalescer::batchReady, this, &MainWindow::flushLogBatch);
 }
 
 bool MainWindow::eventFilter(QObject *watched, QEvent *event) {
@@ -598,332 +641,184 @@ void MainWindow::sendModeChangeRequest(const QString &mode, const CameraInfo &ca
         return;
     }
 
-    if (!socketMap.contains(camera.ip)) {
+    if (!connectedIps.contains(camera.ip)) {
         qWarning() << "[모드 변경] WebSocket 연결 없음 →" << camera.name;
         return;
     }
 
-    QWebSocket *socket = socketMap[camera.ip];
-    if (socket->state() != QAbstractSocket::ConnectedState) {
-        qWarning() << "[모드 변경] WebSocket 비연결 상태 →" << camera.name;
-        return;
-    }
-
     // WebSocket 메시지 생성
     QJsonObject payload;
     payload["type"] = "set_mode";
     payload["mode"] = mode;
 
-    QJsonDocument doc(payload);
-    QString message = doc.toJson(QJsonDocument::Compact);
-    socket->sendTextMessage(message);
+    sendToCamera(camera.ip, payload);
 
-    qDebug() << "[WebSocket] 모드 변경 메시지 전송됨:" << message;
+    qDebug() << "[WebSocket] 모드 변경 메시지 전송됨:" << payload;
 }
 
-/*
-void MainWindow::setupWebSocketConnections()
+void MainWindow::sendToCamera(const QString &ip, const QJsonObject &payload)
 {
-    for (const CameraInfo &camera : cameraList) {
-        // 이미 연결된 경우 생략
-        if (socketMap.contains(camera.ip)) {
-            QWebSocket *existing = socketMap[camera.ip];
-            if (existing && existing->state() == QAbstractSocket::ConnectedState) {
-                continue;
-            }
-        }
-
-        QWebSocket *socket = new QWebSocket();
+    QString message = QJsonDocument(payload).toJson(QJsonDocument::Compact);
+    QMetaObject::invokeMethod(ingestWorker, [worker = ingestWorker, ip, message]() {
+        worker->sendMessage(ip, message);
+    }, Qt::QueuedConnection);
+}
 
-        connect(socket, &QWebSocket::sslErrors, this, [socket](const QList<QSslError> &) {
-            socket->ignoreSslErrors();
-        });
+void MainWindow::setupWebSocketConnections()
+{
+    // ✅ 소켓 생성/연결은 수신 스레드에서 수행
+    QMetaObject::invokeMethod(ingestWorker, [worker = ingestWorker, cameras = cameraList]() {
+        worker->syncCameras(cameras);
+    }, Qt::QueuedConnection);
+}
 
-        connect(socket, &QWebSocket::connected, this, [=]() {
-            qDebug() << "[WebSocket 연결 성공]" << camera.ip;
-            socketMap[camera.ip] = socket;  // ✅ 연결 성공 후에 등록
+void MainWindow::onSocketConnected(const QString &ip) {
+    connectedIps.insert(ip);
 
-            // 초기 헬시 상태 설정할 수도 있음
-            for (int i = 0; i < listLayout->count(); ++i) {
-                if (CameraItemWidget *w = qobject_cast<CameraItemWidget *>(listLayout->itemAt(i)->widget())) {
-                    if (w->getCameraInfo().ip == camera.ip) {
-                        w->updateHealthStatus("🔗 연결됨", "lightblue");
-                        break;
-                    }
+    const CameraInfo *cameraPtr = nullptr;
+    for (const CameraInfo &cam : cameraList) {
+        if (cam.ip == ip) {
+            cameraPtr = &cam;
+            break;
+        }
+    }
+    if (!cameraPtr) return;
+    const CameraInfo camera = *cameraPtr;
+
+    for (int i = 0; i < listLayout->count(); ++i) {
+        if (CameraItemWidget *w = qobject_cast<CameraItemWidget *>(listLayout->itemAt(i)->widget())) {
+            if (w->getCameraInfo().ip == camera.ip) {
+                // ✅ 연결 상태 표시
+                w->updateHealthStatus("🔗 연결됨", "lightblue");
+
+                // ✅ 재연결 시 무조건 Raw 모드로 초기화
+                if (QComboBox *combo = w->findChild<QComboBox*>()) {
+                    combo->setCurrentText("Raw");
                 }
-            }
-        });
-
-        connect(socket, &QWebSocket::disconnected, this, [=]() {
-            qDebug() << "[WebSocket 연결 해제]" << camera.ip;
-            socket->deleteLater();
-            socketMap.remove(camera.ip);
+                sendModeChangeRequest("raw", camera);
+                qDebug() << "[모드 초기화] 재연결 시 Raw 모드 적용됨:" << camera.ip;
 
-            for (int i = 0; i < listLayout->count(); ++i) {
-                if (CameraItemWidget *w = qobject_cast<CameraItemWidget *>(listLayout->itemAt(i)->widget())) {
-                    if (w->getCameraInfo().ip == camera.ip) {
-                        w->updateHealthStatus("❌ 미연결", "orange");
-                        break;
-                    }
-                }
+                break;
             }
-        });
+        }
+    }
 
-        connect(socket, &QWebSocket::errorOccurred, this, [=](QAbstractSocket::SocketError error) {
-            qWarning() << "[WebSocket 에러]" << camera.ip << error;
-            // 연결 에러가 발생해도 연결 시도는 하되, 상태 업데이트
-            for (int i = 0; i < listLayout->count(); ++i) {
-                if (CameraItemWidget *w = qobject_cast<CameraItemWidget *>(listLayout->itemAt(i)->widget())) {
-                    if (w->getCameraInfo().ip == camera.ip) {
-                        w->updateHealthStatus("❌ 연결 실패", "red");
-                        break;
-                    }
-                }
-            }
-        });
+    // ✅ (재)연결 시 끊겨 있던 동안의 이력만 받아옴 (재시도 간격도 처음부터)
+    historyRetryDelay.remove(ip);
+    syncCameraHistory(camera);
 
-        connect(socket, &QWebSocket::textMessageReceived,
-                this, &MainWindow::onSocketMessageReceived);
+    // ✅ 최초 헬시체크 요청 자동 전송
+    QJsonObject req;
+    req["type"] = "request_stm_status";
+    sendToCamera(camera.ip, req);
 
-        QString wsUrl = QString("wss://%1:8443/ws").arg(camera.ip);
-        socket->open(QUrl(wsUrl));  // ✅ 연결 시도는 하지만, 등록은 성공 후에만
+    qDebug() << "[헬시체크 자동 요청]" << camera.ip;
 
-        // WebSocket 연결 성공 시 처리
-        connect(socket, &QWebSocket::connected, this, [=]() {
-            qDebug() << "[WebSocket 연결 성공]" << camera.ip;
-            socketMap[camera.ip] = socket;
+    // ⏳ 헬시체크 상태 대기 UI 반영
+    for (int i = 0; i < listLayout->count(); ++i) {
+        if (CameraItemWidget *w = qobject_cast<CameraItemWidget *>(listLayout->itemAt(i)->widget())) {
+            if (w->getCameraInfo().ip == camera.ip) {
+                w->updateHealthStatus("⏳ 확인 중", "gray");
+                break;
+            }
+        }
+    }
 
-            // ✅ 연결됨 표시
+    // ⏱️ 5초 내 응답 없으면 경고 표시
+    QTimer::singleShot(5000, this, [=]() {
+        if (!healthCheckResponded.contains(camera.ip)) {
             for (int i = 0; i < listLayout->count(); ++i) {
                 if (CameraItemWidget *w = qobject_cast<CameraItemWidget *>(listLayout->itemAt(i)->widget())) {
                     if (w->getCameraInfo().ip == camera.ip) {
-                        w->updateHealthStatus("🔗 연결됨", "lightblue");
+                        w->updateHealthStatus("⚠️ 센서 상태를 점검하세요", "#f37321");
                         break;
                     }
                 }
             }
+        }
+    });
+}
 
-            // ✅ 최초 헬시체크 요청 자동 전송
-            QJsonObject req;
-            req["type"] = "request_stm_status";
-            QJsonDocument doc(req);
-            socket->sendTextMessage(doc.toJson(QJsonDocument::Compact));
-
-            qDebug() << "[헬시체크 자동 요청]" << camera.ip;
+void MainWindow::onSocketDisconnected(const QString &ip) {
+    connectedIps.remove(ip);
 
-            // ⏳ 헬시체크 상태 대기 UI 반영
-            for (int i = 0; i < listLayout->count(); ++i) {
-                if (CameraItemWidget *w = qobject_cast<CameraItemWidget *>(listLayout->itemAt(i)->widget())) {
-                    if (w->getCameraInfo().ip == camera.ip) {
-                        w->updateHealthStatus("⏳ 확인 중", "gray");
-                        break;
-                    }
-                }
+    for (int i = 0; i < listLayout->count(); ++i) {
+        if (CameraItemWidget *w = qobject_cast<CameraItemWidget *>(listLayout->itemAt(i)->widget())) {
+            if (w->getCameraInfo().ip == ip) {
+                w->updateHealthStatus("❌ 미연결", "orange");
+                break;
             }
-
-            // ⏱️ 5초 내 응답 없으면 경고 표시
-            QTimer::singleShot(5000, this, [=]() {
-                if (!healthCheckResponded.contains(camera.ip)) {
-                    for (int i = 0; i < listLayout->count(); ++i) {
-                        if (CameraItemWidget *w = qobject_cast<CameraItemWidget *>(listLayout->itemAt(i)->widget())) {
-                            if (w->getCameraInfo().ip == camera.ip) {
-                                w->updateHealthStatus("⚠️ 센서 상태를 점검하세요", "#f37321");
-                                break;
-                            }
-                        }
-                    }
-                }
-            });
-        });
+        }
     }
 }
-*/
 
-void MainWindow::setupWebSocketConnections()
-{
-    for (const CameraInfo &camera : cameraList) {
-        // 이미 연결된 경우 생략
-        if (socketMap.contains(camera.ip)) {
-            QWebSocket *existing = socketMap[camera.ip];
-            if (existing && existing->state() == QAbstractSocket::ConnectedState) {
-                continue;
+void MainWindow::onSocketErrorOccurred(const QString &ip, QAbstractSocket::SocketError error) {
+    Q_UNUSED(error);
+    for (int i = 0; i < listLayout->count(); ++i) {
+        if (CameraItemWidget *w = qobject_cast<CameraItemWidget *>(listLayout->itemAt(i)->widget())) {
+            if (w->getCameraInfo().ip == ip) {
+                w->updateHealthStatus("❌ 연결 실패", "red");
+                break;
             }
         }
-
-        QWebSocket *socket = new QWebSocket();
-
-        connect(socket, &QWebSocket::sslErrors, this, [socket](const QList<QSslError> &) {
-            socket->ignoreSslErrors();
-        });
-
-        connect(socket, &QWebSocket::connected, this, [=]() {
-            qDebug() << "[WebSocket 연결 성공]" << camera.ip;
-            socketMap[camera.ip] = socket;  // ✅ 연결 성공 후에 등록
-
-            for (int i = 0; i < listLayout->count(); ++i) {
-                if (CameraItemWidget *w = qobject_cast<CameraItemWidget *>(listLayout->itemAt(i)->widget())) {
-                    if (w->getCameraInfo().ip == camera.ip) {
-                        // ✅ 연결 상태 표시
-                        w->updateHealthStatus("🔗 연결됨", "lightblue");
-
-                        // ✅ 재연결 시 무조건 Raw 모드로 초기화
-                        if (QComboBox *combo = w->findChild<QComboBox*>()) {
-                            combo->setCurrentText("Raw");
-                        }
-                        sendModeChangeRequest("raw", camera);
-                        qDebug() << "[모드 초기화] 재연결 시 Raw 모드 적용됨:" << camera.ip;
-
-                        break;
-                    }
-                }
-            }
-
-            // ✅ 최초 헬시체크 요청 자동 전송
-            QJsonObject req;
-            req["type"] = "request_stm_status";
-            QJsonDocument doc(req);
-            socket->sendTextMessage(doc.toJson(QJsonDocument::Compact));
-
-            qDebug() << "[헬시체크 자동 요청]" << camera.ip;
-
-            // ⏳ 헬시체크 상태 대기 UI 반영
-            for (int i = 0; i < listLayout->count(); ++i) {
-                if (CameraItemWidget *w = qobject_cast<CameraItemWidget *>(listLayout->itemAt(i)->widget())) {
-                    if (w->getCameraInfo().ip == camera.ip) {
-                        w->updateHealthStatus("⏳ 확인 중", "gray");
-                        break;
-                    }
-                }
-            }
-
-            // ⏱️ 5초 내 응답 없으면 경고 표시
-            QTimer::singleShot(5000, this, [=]() {
-                if (!healthCheckResponded.contains(camera.ip)) {
-                    for (int i = 0; i < listLayout->count(); ++i) {
-                        if (CameraItemWidget *w = qobject_cast<CameraItemWidget *>(listLayout->itemAt(i)->widget())) {
-                            if (w->getCameraInfo().ip == camera.ip) {
-                                w->updateHealthStatus("⚠️ 센서 상태를 점검하세요", "#f37321");
-                                break;
-                            }
-                        }
-                    }
-                }
-            });
-        });
-
-        connect(socket, &QWebSocket::disconnected, this, [=]() {
-            qDebug() << "[WebSocket 연결 해제]" << camera.ip;
-            socket->deleteLater();
-            socketMap.remove(camera.ip);
-
-            for (int i = 0; i < listLayout->count(); ++i) {
-                if (CameraItemWidget *w = qobject_cast<CameraItemWidget *>(listLayout->itemAt(i)->widget())) {
-                    if (w->getCameraInfo().ip == camera.ip) {
-                        w->updateHealthStatus("❌ 미연결", "orange");
-                        break;
-                    }
-                }
-            }
-        });
-
-        connect(socket, &QWebSocket::errorOccurred, this, [=](QAbstractSocket::SocketError error) {
-            qWarning() << "[WebSocket 에러]" << camera.ip << error;
-            for (int i = 0; i < listLayout->count(); ++i) {
-                if (CameraItemWidget *w = qobject_cast<CameraItemWidget *>(listLayout->itemAt(i)->widget())) {
-                    if (w->getCameraInfo().ip == camera.ip) {
-                        w->updateHealthStatus("❌ 연결 실패", "red");
-                        break;
-                    }
-                }
-            }
-        });
-
-        connect(socket, &QWebSocket::textMessageReceived,
-                this, &MainWindow::onSocketMessageReceived);
-
-        QString wsUrl = QString("wss://%1:8443/ws").arg(camera.ip);
-        socket->open(QUrl(wsUrl));  // ✅ 연결 시도
     }
 }
 
-void MainWindow::onSocketConnected() {
-    qDebug() << "[WebSocket] 연결됨";
-}
+void MainWindow::onCameraEvent(const CameraEvent &event)
+{
+    QElapsedTimer guiTimer;
+    guiTimer.start();
 
-void MainWindow::onSocketDisconnected() {
-    qDebug() << "[WebSocket] 연결 해제됨";
-}
+    handleCameraEvent(event);
 
-void MainWindow::onSocketErrorOccurred(QAbstractSocket::SocketError error) {
-    qWarning() << "[WebSocket] 에러 발생:" << error;
+    recordGuiTiming(event.parseNsecs, guiTimer.nsecsElapsed());
 }
 
-void MainWindow::onSocketMessageReceived(const QString &message)
+void MainWindow::recordGuiTiming(qint64 parseNsecs, qint64 guiNsecs)
 {
-    qDebug() << "[WebSocket 수신 메시지]" << message;
-
-    QJsonDocument doc = QJsonDocument::fromJson(message.toUtf8());
-    if (!doc.isObject()) {
-        qWarning() << "[WebSocket 메시지] JSON 파싱 실패";
-        return;
-    }
-
-    QJsonObject obj = doc.object();
-    QString type = obj["type"].toString();
-    QJsonObject data = obj["data"].toObject();
-
-    qDebug() << "📨 [WebSocket 타입]" << type;
-
-    QString ipSender;
-    QWebSocket *senderSocket = qobject_cast<QWebSocket*>(sender());
-    for (auto it = socketMap.begin(); it != socketMap.end(); ++it) {
-        if (it.value() == senderSocket) {
-            ipSender = it.key();
-            break;
-        }
-    }
+    // 📊 "이전" 비용 = 파싱 + 처리 (모두 GUI 스레드), "현재" 비용 = 처리만
+    ++timingCount;
+    guiNsecsTotal += guiNsecs;
+    guiNsecsMax = std::max(guiNsecsMax, guiNsecs);
+    parseNsecsTotal += parseNsecs;
+
+    if (timingCount < 200) return;
+
+    qDebug().noquote() << QString("[GUI 처리 시간] 최근 %1건 평균 %2 us (최대 %3 us) | 수신 스레드 파싱 평균 %4 us")
+                              .arg(timingCount)
+                              .arg(guiNsecsTotal / timingCount / 1000.0, 0, 'f', 1)
+                              .arg(guiNsecsMax / 1000.0, 0, 'f', 1)
+                              .arg(parseNsecsTotal / timingCount / 1000.0, 0, 'f', 1);
+
+    timingCount = 0;
+    guiNsecsTotal = 0;
+    guiNsecsMax = 0;
+    parseNsecsTotal = 0;
+}
 
-    if (ipSender.isEmpty()) {
-        qWarning() << "[WebSocket] 발신자 IP 찾기 실패";
-        return;
-    }
+void MainWindow::handleCameraEvent(const CameraEvent &event)
+{
+    qDebug() << "📨 [WebSocket 타입]" << event.typeName;
 
     const CameraInfo *cameraPtr = nullptr;
     for (int i = 0; i < cameraList.size(); ++i) {
-        if (cameraList[i].ip.trimmed() == ipSender.trimmed()) {
+        if (cameraList[i].ip.trimmed() == event.cameraIp.trimmed()) {
             cameraPtr = &cameraList[i];
             break;
         }
     }
 
     if (!cameraPtr) {
-        qWarning() << "[WebSocket] CameraInfo 찾기 실패 for IP:" << ipSender;
+        qWarning() << "[WebSocket] CameraInfo 찾기 실패 for IP:" << event.cameraIp;
         return;
     }
     const CameraInfo &camera = *cameraPtr;
 
-    if (type == "new_detection") {
-        int person = data["person_count"].toInt();
-        int helmet = data["helmet_count"].toInt();
-        int vest = data["safety_vest_count"].toInt();
-        double conf = data["avg_confidence"].toDouble();
-        QString imagePath = data["image_path"].toString();
-        QString ts = data["timestamp"].toString();
-
-        QString event;
-        QString details = QString("👷 %1명 | ⛑️ %2명 | 🦺 %3명 | 신뢰도: %4")
-                              .arg(person).arg(helmet).arg(vest).arg(conf, 0, 'f', 2);
+    switch (event.type) {
+    case CameraEvent::Type::Detection: {
+        qDebug() << "[PPE 이벤트]" << event.event << "IP:" << camera.ip;
 
-        if (helmet < person && vest >= person)
-            event = "⛑️ 헬멧 미착용 감지";
-        else if (vest < person && helmet >= person)
-            event = "🦺 조끼 미착용 감지";
-        else
-            event = "⛑️ 🦺 PPE 미착용 감지";
-
-        qDebug() << "[PPE 이벤트]" << event << "IP:" << camera.ip;
-
-        if (event.contains("미착용")) {
+        if (event.ppeViolation) {
             int count = ppeViolationStreakMap[camera.name] + 1;
             ppeViolationStreakMap[camera.name] = count;
 
@@ -966,28 +861,20 @@ void MainWindow::onSocketMessageReceived(const QString &message)
                 layout->addWidget(textLabel);
 
                 // 이미지가 있을 경우 비동기 로딩
-                if (!imagePath.isEmpty()) {
-                    QString cleanPath = imagePath;
+                if (!event.imagePath.isEmpty()) {
+                    QString cleanPath = event.imagePath;
                     if (cleanPath.startsWith("../"))
                         cleanPath = cleanPath.mid(3);
                     QString urlStr = QString("http://%1/%2").arg(camera.ip, cleanPath);
-                    QUrl url(urlStr);
-                    QNetworkRequest request(url);
 
-                    QNetworkAccessManager *manager = new QNetworkAccessManager(popup);
-                    QNetworkReply *reply = manager->get(request);
-
-                    connect(reply, &QNetworkReply::finished, popup, [=]() {
-                        reply->deleteLater();
-                        QPixmap pix;
-                        pix.loadFromData(reply->readAll());
+                    ImageCache::instance()->request(urlStr, QSize(400, 300), popup, [=](const QPixmap &pix) {
                         if (!pix.isNull()) {
                             QLabel *imgLabel = new QLabel();
-                            imgLabel->setPixmap(pix.scaled(400, 300, Qt::KeepAspectRatio, Qt::SmoothTransformation));
+                            imgLabel->setPixmap(pix);
                             layout->addWidget(imgLabel);
                             popup->adjustSize();
                         }
-                    });
+                    }, NetworkClient::Normal);
                 }
 
                 // 확인 버튼
@@ -1004,75 +891,31 @@ void MainWindow::onSocketMessageReceived(const QString &message)
             ppeViolationStreakMap[camera.name] = 0;
         }
 
-        addLogEntry(camera.name, "PPE", event, imagePath, details, camera.ip, ts);
-    }
-
-    else if (type == "new_trespass") {
-        QString ts = data["timestamp"].toString();
-        int count = data["count"].toInt();
-        QString imagePath = data["image_path"].toString();  // ✅ 추가
-
-        if (count > 0) {
-            QString event = QString("🚷 무단 침입 감지 (%1명)").arg(count);
-            QString details = QString("감지 시각: %1 | 침입자 수: %2").arg(ts).arg(count);
-            addLogEntry(camera.name, "Trespass", event, imagePath, details, camera.ip, ts);  // ✅ 이미지 포함
-        }
-    }
-
-    else if (type == "new_blur") {
-        QString ts = data["timestamp"].toString();
-        QString key = camera.name + "_" + ts;
-        if (recentBlurLogKeys.contains(key)) {
-            qDebug() << "[BLUR 중복 무시]" << key;
-            return;
-        }
-
-        int count = data["count"].toInt();
-        QString event = QString("🔍 %1명 감지").arg(count);
-        addLogEntry(camera.name, "Blur", event, "", "", camera.ip, ts);
-        recentBlurLogKeys.insert(key);
+        addLogEntry(camera.name, event.function, event.event, event.imagePath, event.details, camera.ip, event.timestamp);
+        break;
     }
 
-    else if (type == "anomaly_status") {
-        QString status = data["status"].toString();
-        QString timestamp = data["timestamp"].toString();
+    case CameraEvent::Type::Trespass:
+    case CameraEvent::Type::Fall:
+    case CameraEvent::Type::Blur:
+        addLogEntry(camera.name, event.function, event.event, event.imagePath, event.details, camera.ip, event.timestamp);
+        break;
 
-        qDebug() << "[이상소음 상태]" << status << "at" << timestamp;
+    case CameraEvent::Type::AnomalyStatus: {
+        const QString &status = event.status;
 
         if (status == "detected" && lastAnomalyStatus[camera.name] != "detected") {
-            addLogEntry(camera.name, "Sound", "⚠️ 이상소음 감지됨", "", "이상소음 발생", camera.ip, timestamp);
+            addLogEntry(camera.name, "Sound", "⚠️ 이상소음 감지됨", "", "이상소음 발생", camera.ip, event.timestamp);
         }
         else if (status == "cleared" && lastAnomalyStatus[camera.name] == "detected") {
-            addLogEntry(camera.name, "Sound", "✅ 이상소음 해제됨", "", "이상소음 정상 상태", camera.ip, timestamp);
+            addLogEntry(camera.name, "Sound", "✅ 이상소음 해제됨", "", "이상소음 정상 상태", camera.ip, event.timestamp);
         }
 
         lastAnomalyStatus[camera.name] = status;
+        break;
     }
 
-    else if (type == "new_fall") {
-        QString ts = data["timestamp"].toString();
-        int count = data["count"].toInt();
-        QString imagePath = data["image_path"].toString();  // ✅ 추가
-
-        if (count > 0) {
-            QString event = "🚨 낙상 감지";
-            QString details = QString("낙상 감지 시각: %1").arg(ts);
-            addLogEntry(camera.name, "Fall", event, imagePath, details, camera.ip, ts);  // ✅ new_trespass 방식과 동일
-        }
-    }
-
-    else if (type == "stm_status_update") {
-        double temp = data["temperature"].toDouble();
-        int light = data["light"].toInt();
-        bool buzzer = data["buzzer_on"].toBool();
-        bool led = data["led_on"].toBool();
-
-        QString details = QString("🌡️ 온도: %1°C | 💡 밝기: %2 | 🔔 버저: %3 | 💡 LED: %4")
-                              .arg(temp, 0, 'f', 2)
-                              .arg(light)
-                              .arg(buzzer ? "ON" : "OFF")
-                              .arg(led ? "ON" : "OFF");
-
+    case CameraEvent::Type::StmStatus:
         healthCheckResponded.insert(camera.ip);
 
         // ✅ 여기 추가해야 드롭다운 옆에 "✅ 정상"이 뜸!
@@ -1085,34 +928,23 @@ void MainWindow::onSocketMessageReceived(const QString &message)
                 }
             }
         }
-    }
-
-
-    else if (type == "mode_change_ack") {
-        QString status = obj["status"].toString();
-        QString mode = obj["mode"].toString();
-        QString message = obj["message"].toString();
+        break;
 
-        if (status == "error") {
-            qWarning() << "[모드 변경 실패]" << message;
-            QMessageBox::warning(this, "모드 변경 실패", message);
+    case CameraEvent::Type::ModeChangeAck:
+        if (event.status == "error") {
+            qWarning() << "[모드 변경 실패]" << event.message;
+            QMessageBox::warning(this, "모드 변경 실패", event.message);
         } else {
-            qDebug() << "[모드 변경 성공 응답]" << mode;
+            qDebug() << "[모드 변경 성공 응답]" << event.mode;
         }
-    }
-
-    else if (type == "log") {
-        QString event = data["event"].toString();
-        QString details = data["details"].toString();
-        QString function = data["function"].toString();  // 예: "Blur", "PPE" 등
-        QString imagePath = data["image_path"].toString();
-        QString ts = data["timestamp"].toString();
+        break;
 
-        addLogEntry(camera.name, function, event, imagePath, details, camera.ip);
-    }
+    case CameraEvent::Type::Log:
+        addLogEntry(camera.name, event.function, event.event, event.imagePath, event.details, camera.ip);
+        break;
 
-    else {
-        qWarning() << "[WebSocket] 알 수 없는 타입 수신:" << type;
+    case CameraEvent::Type::Unknown:
+        break;
     }
 }
 
@@ -1132,150 +964,209 @@ void MainWindow::addLogEntry(const QString &cameraName,
         imageUrl = QString("http://%1/%2").arg(ip, cleanPath);
     }
 
-    logEntries.insert(0, {cameraName, function, event, time, imageUrl});
+    LogEntry entry{cameraName, function, event, time, imageUrl, details};
+    logEntries.append(entry);
+    eventStore.append(entry);
 
-    LogItemWidget *logItem = new LogItemWidget(cameraName, event, time, imageUrl);
-    eventLogLayout->insertWidget(0, logItem);
+    // ✅ 위젯 생성은 배치로 모아서 UI 틱마다 한 번에
+    logCoalescer->enqueue(entry);
+}
 
-    if (eventLogLayout->count() > 100) {
-        QLayoutItem *oldItem = eventLogLayout->takeAt(eventLogLayout->count() - 1);
-        if (oldItem && oldItem->widget()) delete oldItem->widget();
-    }
+void MainWindow::flushLogBatch(const QVector<LogEntry> &batch)
+{
+    // 배치 단위로 한 번에 삽입 → 뷰 레이아웃/페인트 1회
+    eventLogModel->prependBatch(batch);
 }
 
-void MainWindow::loadInitialLogs()
+void MainWindow::loadStoredLogs()
 {
-    logEntries.clear();  // 초기화
+    // 메모리에 둘 기간 중 링에 들어갈 만큼만 최신 순으로 읽음 (그 이전은 디스크에만 남음)
+    logEntries.merge(eventStore.readNewest(maxLogEntries, QDateTime::currentMSecsSinceEpoch() - logRetentionMs));
+    loadHistoryCursors();
+    qDebug() << "[저장된 로그 복원]" << logEntries.size() << "건";
+}
 
-    int totalRequests = cameraList.size() * 3;  // Detect + Trespass + Fall
-    int *completedCount = new int(0);  // 람다에서 사용 가능하도록 동적 할당
+namespace {
+QString historyCursorPath()
+{
+    return EventStore::defaultDirectory() + "/history_cursors.json";
+}
+}
 
-    // ✅ std::function으로 정의해야 const lambda 안에서도 호출 가능
-    std::function<void()> trySortAndPrint;
+void MainWindow::loadHistoryCursors()
+{
+    QFile file(historyCursorPath());
+    if (!file.open(QIODevice::ReadOnly)) return;
+
+    // { "<카메라 이름>": { "<기능>": ms, ... }, ... }
+    const QJsonObject cameras = QJsonDocument::fromJson(file.readAll()).object();
+    for (auto camera = cameras.begin(); camera != cameras.end(); ++camera) {
+        const QJsonObject functions = camera.value().toObject();
+        for (auto function = functions.begin(); function != functions.end(); ++function) {
+            const quint64 key = cursorKey(EventStrings::intern(camera.key()), EventStrings::intern(function.key()));
+            historyCursor.insert(key, qint64(function.value().toDouble()));
+        }
+    }
+}
 
-    trySortAndPrint = [=]() {
-        (*completedCount)++;
-        if (*completedCount == totalRequests) {
-            qDebug() << "[모든 초기 로그 수신 완료] 총" << logEntries.size() << "건";
+void MainWindow::saveHistoryCursors() const
+{
+    QJsonObject cameras;
+    for (auto it = historyCursor.cbegin(); it != historyCursor.cend(); ++it) {
+        const QString camera = EventStrings::text(quint32(it.key() >> 32));
+        QJsonObject functions = cameras.value(camera).toObject();
+        functions.insert(EventStrings::text(quint32(it.key())), double(it.value()));
+        cameras.insert(camera, functions);
+    }
 
-            std::sort(logEntries.begin(), logEntries.end(), [](const LogEntry &a, const LogEntry &b) {
-                return QDateTime::fromString(a.timestamp, "yyyy-MM-dd HH:mm:ss") >
-                       QDateTime::fromString(b.timestamp, "yyyy-MM-dd HH:mm:ss");
-            });
+    QSaveFile file(historyCursorPath());
+    if (!file.open(QIODevice::WriteOnly)) return;
+    file.write(QJsonDocument(cameras).toJson(QJsonDocument::Compact));
+    if (!file.commit()) qWarning() << "[이력 커서] 저장 실패:" << file.errorString();
+}
 
-            delete completedCount;  // 누수 방지
-        }
-    };
+quint64 MainWindow::cursorKey(quint32 camera, quint32 function)
+{
+    return (quint64(camera) << 32) | function;
+}
 
-    for (const CameraInfo &camera : cameraList) {
-        // ✅ PPE 요청
-        QString urlPPE = QString("https://%1:8443/api/detections").arg(camera.ip);
-        QNetworkRequest reqPPE{QUrl(urlPPE)};
-        QNetworkReply *replyPPE = networkManager->get(reqPPE);
-        replyPPE->ignoreSslErrors();
-
-        connect(replyPPE, &QNetworkReply::finished, this, [=]() {
-            replyPPE->deleteLater();
-            if (replyPPE->error() != QNetworkReply::NoError) return trySortAndPrint();
-
-            QJsonDocument doc = QJsonDocument::fromJson(replyPPE->readAll());
-            if (!doc.isObject()) return trySortAndPrint();
-
-            QJsonArray arr = doc["detections"].toArray();
-            for (const QJsonValue &val : arr) {
-                QJsonObject obj = val.toObject();
-                QString ts = obj["timestamp"].toString();
-                int person = obj["person_count"].toInt();
-                int helmet = obj["helmet_count"].toInt();
-                int vest = obj["safety_vest_count"].toInt();
-                double conf = obj["avg_confidence"].toDouble();
-                QString imgPath = obj["image_path"].toString();
-
-                QString event;
-                if (helmet < person && vest >= person)
-                    event = "⛑️ 헬멧 미착용 감지";
-                else if (vest < person && helmet >= person)
-                    event = "🦺 조끼 미착용 감지";
-                else
-                    event = "⛑️ 🦺 PPE 미착용 감지";
-
-                QString imageUrl;
-                if (!imgPath.isEmpty()) {
-                    QString cleanPath = imgPath.startsWith("../") ? imgPath.mid(3) : imgPath;
-                    imageUrl = QString("http://%1/%2").arg(camera.ip, cleanPath);
-                }
+void MainWindow::advanceCursor(QHash<quint64, qint64> &cursors, const EventRecord &record)
+{
+    if (record.time == 0) return;
+    qint64 &cursor = cursors[cursorKey(record.camera, record.function)];
+    cursor = std::max(cursor, record.time);
+}
 
-                logEntries.append({camera.name, "PPE", event, ts, imageUrl});
-            }
+bool MainWindow::isNewHistoryEntry(qint64 since, const EventRecord &record) const
+{
+    // 시각이 없는 이력은 중복 판정도, 링 안의 자리도 정할 수 없음 → 버림
+    //    (새 것으로 보면 동기화할 때마다 저장소에 현재 시각으로 다시 기록됨)
+    //    서버 시각 없는 실시간 이벤트는 addLogEntry에서 받은 시각으로 보관
+    if (record.time == 0) return false;
+    if (record.time < since) return false;
+
+    // 기준 시각 이후라도 실시간으로 먼저 받은 이벤트일 수 있음 (같은 초에 여러 건이 있을 수 있음)
+    for (quint64 seq = logEntries.lowerBound(record.time);
+         seq < logEntries.endSeq() && logEntries.timeAt(seq) == record.time; ++seq) {
+        if (logEntries.at(seq).sameEvent(record))
+            return false;
+    }
+    return true;
+}
 
-            trySortAndPrint();
-        });
+void MainWindow::queueHistoryRun(const QString &ip, qint64 since, const QVector<LogEntry> &parsed)
+{
+    auto sync = historySyncs.find(ip);
+    if (sync == historySyncs.end()) return;   // 카메라 삭제로 취소됨
+
+    // 페이지를 한 번만 변환 (시각 키도 이때 한 번만 파싱)
+    QVector<EventRecord> run;
+    run.reserve(parsed.size());
+    int untimed = 0;
+    for (const LogEntry &entry : parsed) {
+        EventRecord record = EventRecord::fromEntry(entry, 0);
+        if (record.time == 0) ++untimed;
+        advanceCursor(sync->cursors, record);   // 이미 가진 이벤트도 이 페이지까지는 받았다는 뜻
+        if (!isNewHistoryEntry(since, record)) continue;
+        run.append(std::move(record));
+        sync->fresh.append(entry);
+    }
+    if (untimed > 0) qWarning() << "[이력] 시각을 해석할 수 없는 항목" << untimed << "건 제외";
+    if (run.isEmpty()) return;
 
-        // ✅ 무단 침입 요청
-        QString urlTrespass = QString("https://%1:8443/api/trespass").arg(camera.ip);
-        QNetworkRequest reqTrespass{QUrl(urlTrespass)};
-        QNetworkReply *replyTrespass = networkManager->get(reqTrespass);
-        replyTrespass->ignoreSslErrors();
+    EventRing::sortRun(run);
+    sync->runs.push_back(std::move(run));
+}
 
-        connect(replyTrespass, &QNetworkReply::finished, this, [=]() {
-            replyTrespass->deleteLater();
-            if (replyTrespass->error() != QNetworkReply::NoError) return trySortAndPrint();
+void MainWindow::flushHistoryRuns()
+{
+    if (pendingRuns.empty()) return;
 
-            QJsonDocument doc = QJsonDocument::fromJson(replyTrespass->readAll());
-            if (!doc.isObject()) return trySortAndPrint();
+    const int runCount = int(pendingRuns.size());
+    logEntries.mergeRuns(std::move(pendingRuns));
+    pendingRuns.clear();
 
-            QJsonArray arr = doc["trespass"].toArray();
-            for (const QJsonValue &val : arr) {
-                QJsonObject obj = val.toObject();
-                QString ts = obj["timestamp"].toString();
-                int count = obj["count"].toInt();
-                QString imgPath = obj["image_path"].toString();
+    if (!firstRunMerged) {
+        firstRunMerged = true;
+        qDebug() << "[초기 로그] 첫 이력 반영까지" << historyLoadTimer.elapsed() << "ms (run" << runCount << "개)";
+    }
+}
 
-                QString event = QString("🚷 무단 침입 감지 (%1명)").arg(count);
+void MainWindow::syncCameraHistory(const CameraInfo &camera, const QStringList &functions)
+{
+    // 이미 받는 중이면 생략 (그 사이 이벤트는 실시간으로 들어옴)
+    if (historySyncs.contains(camera.ip)) return;
+    historySyncs[camera.ip].remaining = functions.size();
+
+    if (!historyLoadTimer.isValid()) historyLoadTimer.start();
+
+    // 동기화된 이벤트는 다시 받지 않음 (이 카메라의 기능별 커서 이후부터 페이지 단위로)
+    //    커서가 없으면 (처음 보는 카메라/기능) 링 보관 기간 전체
+    //    → 그보다 오래된 이력은 받아도 링에 남지 않고, 저장소와의 중복도 가릴 수 없음
+    const qint64 fallback = QDateTime::currentMSecsSinceEpoch() - logRetentionMs;
+    const quint32 cameraId = EventStrings::intern(camera.name);
+    for (const QString &function : functions) {
+        const qint64 since = historyCursor.value(cursorKey(cameraId, EventStrings::intern(function)), fallback);
+        HistoryFetcher::instance()->fetch(camera, function, since);
+    }
+}
 
-                QString imageUrl;
-                if (!imgPath.isEmpty()) {
-                    QString cleanPath = imgPath.startsWith("../") ? imgPath.mid(3) : imgPath;
-                    imageUrl = QString("http://%1/%2").arg(camera.ip, cleanPath);
-                }
+void MainWindow::onHistoryFinished(const QString &ip, const QString &function, HistoryFetcher::Result result)
+{
+    auto it = historySyncs.find(ip);
+    if (it == historySyncs.end()) return;
+    if (result == HistoryFetcher::Failed) {
+        qWarning() << "[이력 동기화 실패]" << ip << function;
+        it->retry.append(function);
+    } else if (result == HistoryFetcher::Rejected) {
+        qWarning() << "[이력 동기화 거부] 다시 시도하지 않음:" << ip << function;
+    }
+    if (--it->remaining > 0) return;
+
+    // 받은 페이지 전체를 저장 + 병합 1회로 (실패한 기능도 받은 페이지까지는 반영)
+    //    저장도 여기서 함 → 중간에 취소된 동기화는 저장소에도 링에도 남지 않고, 다음 동기화가 같은 구간을 다시 받음
+    if (!it->runs.empty()) {
+        eventStore.append(it->fresh);
+        if (pendingRuns.empty())
+            QTimer::singleShot(0, this, &MainWindow::flushHistoryRuns);
+        for (QVector<EventRecord> &run : it->runs)
+            pendingRuns.push_back(std::move(run));
+    }
 
-                logEntries.append({camera.name, "Trespass", event, ts, imageUrl});
-            }
+    // 커서는 받은 페이지까지만 (페이지는 오름차순, 서버는 같은 초를 나누지 않음 → 그 이전은 빠짐없음)
+    //    실패한 기능은 마지막으로 받은 페이지에 멈춰 있음 → 다시 시도할 때 거기서부터
+    bool moved = false;
+    for (auto cursor = it->cursors.cbegin(); cursor != it->cursors.cend(); ++cursor) {
+        qint64 &value = historyCursor[cursor.key()];
+        if (cursor.value() > value) {
+            value = cursor.value();
+            moved = true;
+        }
+    }
+    if (moved) saveHistoryCursors();
 
-            trySortAndPrint();
-        });
+    const QStringList retry = it->retry;
+    historySyncs.erase(it);
 
-        QString urlFall = QString("https://%1:8443/api/fall").arg(camera.ip);
-        QNetworkRequest reqFall{QUrl(urlFall)};
-        QNetworkReply *replyFall = networkManager->get(reqFall);  // ✅ 반드시 선언 필요
-        replyFall->ignoreSslErrors();
-
-        connect(replyFall, &QNetworkReply::finished, this, [=]() {
-            replyFall->deleteLater();
-            if (replyFall->error() != QNetworkReply::NoError) return trySortAndPrint();
-
-            QJsonDocument doc = QJsonDocument::fromJson(replyFall->readAll());
-            if (!doc.isObject()) return trySortAndPrint();
-
-            QJsonArray arr = doc["fall"].toArray();
-            for (const QJsonValue &val : arr) {
-                QJsonObject obj = val.toObject();
-                QString ts = obj["timestamp"].toString();
-                int count = obj["count"].toInt();
-                QString imgPath = obj["image_path"].toString();
-
-                QString event = QString("🚨 낙상 감지").arg(count);
-                QString imageUrl;
-                if (!imgPath.isEmpty()) {
-                    QString cleanPath = imgPath.startsWith("../") ? imgPath.mid(3) : imgPath;
-                    imageUrl = QString("http://%1/%2").arg(camera.ip, cleanPath);
-                }
+    if (retry.isEmpty()) {
+        historyRetryDelay.remove(ip);
+        qDebug() << "[이력 동기화 완료]" << ip << "| 전체" << logEntries.size() << "건 (저장소" << eventStore.count() << "건)";
+        return;
+    }
 
-                logEntries.append({camera.name, "Fall", event, ts, imageUrl});
+    // 일시적 실패: 실패한 기능만, 실패할 때마다 두 배씩 늘어나는 간격으로 (재연결하면 처음 간격부터)
+    int &delay = historyRetryDelay[ip];
+    delay = delay == 0 ? historyRetryMinMs : std::min(delay * 2, historyRetryMaxMs);
+    QTimer::singleShot(delay, this, [=]() {
+        // 그 사이 삭제됐거나 끊긴 카메라는 재연결 때 다시 동기화됨
+        if (!connectedIps.contains(ip)) return;
+        for (const CameraInfo &camera : cameraList) {
+            if (camera.ip == ip) {
+                syncCameraHistory(camera, retry);
+                break;
             }
-            trySortAndPrint();
-        });
-    }
+        }
+    });
 }
 
 void MainWindow::performHealthCheck()
@@ -1285,16 +1176,12 @@ void MainWindow::performHealthCheck()
 
     for (const CameraInfo &camera : cameraList) {
         // ✅ 연결 상태까지 확인
-        if (socketMap.contains(camera.ip) &&
-            socketMap[camera.ip]->state() == QAbstractSocket::ConnectedState) {
-
-            QWebSocket *socket = socketMap[camera.ip];
+        if (connectedIps.contains(camera.ip)) {
 
             // ✅ 헬시체크 요청 전송
             QJsonObject req;
             req["type"] = "request_stm_status";
-            QJsonDocument doc(req);
-            socket->sendTextMessage(doc.toJson(QJsonDocument::Compact));
+            sendToCamera(camera.ip, req);
 
             qDebug() << "[헬시 체크 요청 전송됨]" << camera.ip;
 
@@ -5,6 +5,13 @@
 #include "camerainfo.h"
 #include "loghistorydialog.h"  // ✅ 헤더 포함
 #include "logentry.h"  // ✅ 이 줄 꼭 필요함!
+#include "cameraevent.h"
+#include "eventingestworker.h"
+#include "eventlogcoalescer.h"
+#include "eventlogmodel.h"
+#include "eventstore.h"
+#include "eventring.h"
+#include "historyfetcher.h"
 
 #include <QMainWindow>
 #include <QTableWidget>
@@ -22,7 +29,13 @@
 #include <QWidget>
 #include <QVBoxLayout>
 #include <QScrollArea>
+#include <QListView>
 #include <QNetworkAccessManager>  // 이미 있을 수도 있음
+#include <QThread>
+#include <QJsonObject>
+#include <QElapsedTimer>
+
+#include <vector>
 
 class MainWindow : public QMainWindow
 {
@@ -30,7 +43,7 @@ class MainWindow : public QMainWindow
 
 public:
     explicit MainWindow(QWidget *parent = nullptr);
-    ~MainWindow() = default;
+    ~MainWindow();
 
 protected:
     bool eventFilter(QObject *watched, QEvent *event) override;
@@ -68,23 +81,37 @@ private:
     void setupEventLog();
     QTableWidget *eventLogPanel;
 
-    QMap<QString, QWebSocket*> socketMap;    // IP 주소 → QWebSocket 포인터 매핑
+    // ✅ WebSocket 수신/파싱 전용 스레드 (소켓은 워커가 소유)
+    QThread *ingestThread = nullptr;
+    EventIngestWorker *ingestWorker = nullptr;
+    QSet<QString> connectedIps;              // 연결 완료된 카메라 IP
     void setupWebSocketConnections();
+    void sendToCamera(const QString &ip, const QJsonObject &payload);
+    void handleCameraEvent(const CameraEvent &event);
+
+    // ✅ GUI 스레드 메시지 처리 시간 측정
+    void recordGuiTiming(qint64 parseNsecs, qint64 guiNsecs);
+    int timingCount = 0;
+    qint64 guiNsecsTotal = 0;
+    qint64 guiNsecsMax = 0;
+    qint64 parseNsecsTotal = 0;
 
     // ✅ PPE 위반 연속 감지 카운터
     QMap<QString, int> ppeViolationStreakMap;
 
-    // ✅ Blur 중복 방지용 키 저장
-    QSet<QString> recentBlurLogKeys;
-
     // ✅ 이상소음 상태 기억용
     QMap<QString, QString> lastAnomalyStatus;
 
     QSet<QString> healthCheckResponded;
 
     QWidget *eventLogPanelWrapper;
-    QVBoxLayout *eventLogLayout;
-    QScrollArea *eventLogScroll;
+    QListView *eventLogView;
+    EventLogModel *eventLogModel;
+
+    // ✅ 실시간 로그 배치 반영 (30Hz)
+    static constexpr int maxLiveLogItems = 5000;
+    EventLogCoalescer *logCoalescer = nullptr;
+    void flushLogBatch(const QVector<LogEntry> &batch);
 
     void addLogEntry(const QString &cameraName,
                      const QString &function,
@@ -96,11 +123,48 @@ private:
 
     QPushButton *viewAllLogsButton;  // ✅ 로그 다이얼로그 버튼
 
-    QVector<LogEntry> logEntries;  // ✅ 전체 로그 누적 저장
-
-    void loadInitialLogs();  // ✅ 선언 추가
-
-    QNetworkAccessManager *networkManager;  // ✅ 네트워크 요청용
+    // ✅ 전체 로그 (시각 순 링: 꼬리 추가 O(1), 개수/기간 한도 넘으면 오래된 것부터 밀려남)
+    static constexpr int maxLogEntries = 200000;
+    static constexpr qint64 logRetentionMs = 30LL * 24 * 3600 * 1000;
+    EventRing logEntries{maxLogEntries, logRetentionMs};
+
+    // ✅ 로컬 이벤트 저장소: 시작 시 여기서 바로 복원, 카메라에서는 새 이벤트만 받음
+    EventStore eventStore;
+    //    동기화 커서: 이력 응답으로 받아 병합까지 끝난 마지막 시각 (실시간 이벤트는 움직이지 않음)
+    //    실시간으로 앞선 이벤트를 받았어도 그 사이 끊긴 구간이 있을 수 있음 → 다음 동기화는 커서부터
+    //    재시작 후에도 이어지도록 파일로 보관 (카메라/기능 이름 기준)
+    QHash<quint64, qint64> historyCursor;    // (카메라 ID, 기능 ID) → 동기화된 마지막 이벤트 시각(ms)
+    static quint64 cursorKey(quint32 camera, quint32 function);
+    static void advanceCursor(QHash<quint64, qint64> &cursors, const EventRecord &record);
+    void loadHistoryCursors();
+    void saveHistoryCursors() const;
+    bool isNewHistoryEntry(qint64 since, const EventRecord &record) const;
+
+    // ✅ 페이지 1개 = 정렬된 run 1개
+    //    이력은 오래된 페이지부터 오므로 페이지마다 병합하면 링 꼬리를 매번 다시 쓰고 다시 색인함
+    //    → 카메라 동기화가 끝날 때까지 run을 모았다가 k-way 병합 1회 (같은 틱에 끝난 카메라끼리도 함께)
+    std::vector<QVector<EventRecord>> pendingRuns;
+    QElapsedTimer historyLoadTimer;          // 첫 이력 표시까지 걸린 시간 측정
+    bool firstRunMerged = false;
+    void queueHistoryRun(const QString &ip, qint64 since, const QVector<LogEntry> &parsed);
+    void flushHistoryRuns();
+
+    void loadStoredLogs();
+
+    // ✅ 카메라 1대 이력 동기화 (등록 / 재연결 시, 커서 이후만, HistoryFetcher가 페이지 단위로 수집)
+    struct HistorySync {
+        int remaining = 0;                   // 남은 기능 수
+        QStringList retry;                   // 일시적으로 실패한 기능 (잠시 뒤 커서부터 다시)
+        std::vector<QVector<EventRecord>> runs;   // 받은 페이지 (동기화가 끝나면 저장 + 병합 한 번에)
+        QVector<LogEntry> fresh;             // runs와 같은 이벤트 (저장소 기록용)
+        QHash<quint64, qint64> cursors;      // 받은 페이지 기준 커서 (병합할 때 반영)
+    };
+    QHash<QString, HistorySync> historySyncs;   // 진행 중인 카메라 IP → 상태
+    QHash<QString, int> historyRetryDelay;      // 카메라 IP → 다음 재시도 간격(ms), 실패할 때마다 두 배
+    static constexpr int historyRetryMinMs = 30 * 1000;
+    static constexpr int historyRetryMaxMs = 10 * 60 * 1000;
+    void syncCameraHistory(const CameraInfo &camera, const QStringList &functions = HistoryFetcher::functions());
+    void onHistoryFinished(const QString &ip, const QString &function, HistoryFetcher::Result result);
 
     void performHealthCheck();  // private: 아래에 추가
 
@@ -109,10 +173,10 @@ private:
 
 private slots:
     void sendModeChangeRequest(const QString &mode, const CameraInfo &camera);
-    void onSocketConnected();
-    void onSocketDisconnected();
-    void onSocketErrorOccurred(QAbstractSocket::SocketError error);
-    void onSocketMessageReceived(const QString &message);
+    void onSocketConnected(const QString &ip);
+    void onSocketDisconnected(const QString &ip);
+    void onSocketErrorOccurred(const QString &ip, QAbstractSocket::SocketError error);
+    void onCameraEvent(const CameraEvent &event);
 };
 
 #endif // MAINWINDOW_H
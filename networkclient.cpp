@@ -0,0 +1,166 @@
+#include "networkclient.h"
+
+#include <QNetworkReply>
+#include <QPointer>
+#include <QUrl>
+#include <QDebug>
+
+#include <algorithm>
+
+NetworkClient *NetworkClient::instance()
+{
+    static NetworkClient *client = new NetworkClient();
+    return client;
+}
+
+NetworkClient::NetworkClient(QObject *parent)
+    : QObject(parent)
+{
+    manager = new QNetworkAccessManager(this);
+}
+
+quint64 NetworkClient::get(const QNetworkRequest &request, Priority priority, QObject *owner,
+                           Handler onFinished, int flags)
+{
+    const quint64 id = nextId++;
+    const QString host = request.url().host();
+
+    QNetworkRequest req = request;
+    req.setRawHeader("Connection", "keep-alive");
+
+    watchOwner(owner);
+    hosts[host].queues[priority].push_back({id, req, owner, std::move(onFinished), flags, host});
+    dispatch(host);
+    return id;
+}
+
+void NetworkClient::watchOwner(QObject *owner)
+{
+    if (!owner || watchedOwners.contains(owner)) return;
+    watchedOwners.insert(owner);
+    connect(owner, &QObject::destroyed, this, [this, owner]() {
+        watchedOwners.remove(owner);
+        cancelOwner(owner);
+    });
+}
+
+void NetworkClient::dispatch(const QString &host)
+{
+    auto it = hosts.find(host);
+    if (it == hosts.end()) return;
+
+    while (it->active < maxPerHost) {
+        std::deque<Job> *queue = nullptr;
+        for (std::deque<Job> &q : it->queues) {
+            if (!q.empty()) {
+                queue = &q;
+                break;
+            }
+        }
+        if (!queue) break;
+
+        Job job = std::move(queue->front());
+        queue->pop_front();
+        ++it->active;
+        start(std::move(job));
+    }
+}
+
+void NetworkClient::start(Job job)
+{
+    QNetworkReply *reply = manager->get(job.request);
+    if (job.flags & IgnoreSslErrors)
+        reply->ignoreSslErrors();
+
+    const quint64 id = job.id;
+    const QString host = job.host;
+    running.insert(id, reply);
+    runningOwners.insert(id, job.owner);
+
+    connect(reply, &QNetworkReply::finished, this, [this, reply, id, host, handler = std::move(job.handler)]() {
+        reply->deleteLater();
+
+        // 취소된 요청은 핸들러 호출 없이 슬롯만 반납
+        bool live = running.remove(id) > 0;
+        runningOwners.remove(id);
+
+        auto it = hosts.find(host);
+        if (it != hosts.end()) --it->active;
+
+        if (live && handler)
+            handler(reply);
+
+        dispatch(host);
+    });
+}
+
+bool NetworkClient::removeQueued(quint64 id, Job *out)
+{
+    for (auto it = hosts.begin(); it != hosts.end(); ++it) {
+        for (std::deque<Job> &q : it->queues) {
+            for (auto jobIt = q.begin(); jobIt != q.end(); ++jobIt) {
+                if (jobIt->id == id) {
+                    if (out) *out = std::move(*jobIt);
+                    q.erase(jobIt);
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+void NetworkClient::setPriority(quint64 id, Priority priority)
+{
+    Job job;
+    if (!removeQueued(id, &job)) return;   // 이미 시작됐으면 무시
+    hosts[job.host].queues[priority].push_back(std::move(job));
+}
+
+void NetworkClient::cancel(quint64 id)
+{
+    if (removeQueued(id)) return;
+
+    if (QNetworkReply *reply = running.take(id)) {
+        runningOwners.remove(id);
+        reply->abort();   // finished → 슬롯 반납 후 다음 요청 시작
+    }
+}
+
+void NetworkClient::cancelOwner(QObject *owner)
+{
+    if (!owner) return;
+
+    for (HostState &state : hosts) {
+        for (std::deque<Job> &q : state.queues) {
+            q.erase(std::remove_if(q.begin(), q.end(), [owner](const Job &job) {
+                        return job.owner == owner;
+                    }), q.end());
+        }
+    }
+
+    const QList<quint64> ids = runningOwners.keys(owner);
+    for (quint64 id : ids)
+        cancel(id);
+}
+
+void NetworkClient::cancelHost(const QString &host)
+{
+    // 이 호스트 대기열이 없어도 알림은 보냄 (HistoryFetcher처럼 자체 대기열을 가진 쪽도 정리해야 함)
+    auto it = hosts.find(host);
+    if (it != hosts.end()) {
+        for (std::deque<Job> &q : it->queues)
+            q.clear();
+    }
+
+    QList<quint64> ids;
+    for (auto runIt = running.constBegin(); runIt != running.constEnd(); ++runIt) {
+        if (runIt.value()->url().host() == host)
+            ids.append(runIt.key());
+    }
+    for (quint64 id : ids)
+        cancel(id);
+
+    qDebug() << "[네트워크] 호스트 요청 취소:" << host << ids.size() << "건 진행 중 중단";
+    emit hostCancelled(host);
+}
@@ -0,0 +1,85 @@
+#ifndef NETWORKCLIENT_H
+#define NETWORKCLIENT_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QNetworkAccessManager>
+#include <QNetworkRequest>
+
+#include <deque>
+#include <functional>
+
+class QNetworkReply;
+
+// ✅ 앱 전체가 함께 쓰는 HTTP 클라이언트
+//    - QNetworkAccessManager 1개 → 카메라별 keep-alive 연결 재사용
+//    - 호스트(카메라)별 동시 요청 수 제한
+//    - 우선순위 큐: 보이는 썸네일/미리보기 > 일반 > 백그라운드 프리페치
+//    - 요청한 객체가 사라지면 대기/진행 중 요청 자동 취소
+class NetworkClient : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Priority {
+        High = 0,     // 화면에 보이는 썸네일, 히스토리 미리보기
+        Normal = 1,   // 초기 로그, 팝업
+        Low = 2       // 백그라운드 프리페치
+    };
+
+    enum Flag {
+        NoFlags = 0,
+        IgnoreSslErrors = 1   // 카메라 자체 서명 인증서
+    };
+
+    // reply는 핸들러 호출 후 클라이언트가 정리 (핸들러에서 deleteLater 불필요)
+    using Handler = std::function<void(QNetworkReply *reply)>;
+
+    static NetworkClient *instance();
+
+    quint64 get(const QNetworkRequest &request, Priority priority, QObject *owner,
+                Handler onFinished, int flags = NoFlags);
+
+    void setPriority(quint64 id, Priority priority);
+    void cancel(quint64 id);
+    void cancelOwner(QObject *owner);
+    void cancelHost(const QString &host);     // 카메라 삭제 시
+
+    void setMaxConnectionsPerHost(int count) { maxPerHost = count; }
+
+signals:
+    void hostCancelled(const QString &host);   // cancelHost 호출마다 (진행 중이던 요청의 핸들러는 호출되지 않음)
+
+private:
+    explicit NetworkClient(QObject *parent = nullptr);
+
+    struct Job {
+        quint64 id;
+        QNetworkRequest request;
+        QObject *owner;           // 비교용 (소멸 감지는 destroyed 시그널)
+        Handler handler;
+        int flags;
+        QString host;
+    };
+
+    struct HostState {
+        int active = 0;
+        std::deque<Job> queues[3];   // 우선순위별 FIFO
+    };
+
+    void watchOwner(QObject *owner);
+    void dispatch(const QString &host);
+    void start(Job job);
+    bool removeQueued(quint64 id, Job *out = nullptr);
+
+    QNetworkAccessManager *manager;
+    QHash<QString, HostState> hosts;
+    QHash<quint64, QNetworkReply*> running;   // id → 진행 중 reply
+    QHash<quint64, QObject*> runningOwners;
+    QSet<QObject*> watchedOwners;
+    quint64 nextId = 1;
+    int maxPerHost = 4;
+};
+
+#endif // NETWORKCLIENT_H
@@ -0,0 +1,644 @@
+#include "simdkernels.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SIMDKERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+// MSVC는 대상 플래그 없이도 모든 intrinsic 사용 가능
+#define SIMD_TARGET_SSE41
+#define SIMD_TARGET_AVX2
+#else
+#define SIMD_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#else
+#define SIMDKERNELS_X86 0
+#endif
+
+namespace SimdKernels {
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// CPU 감지
+// ---------------------------------------------------------------------------
+
+Level detectLevel()
+{
+#if SIMDKERNELS_X86
+    bool sse41 = false;
+    bool avx2 = false;
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    __cpuid(info, 1);
+    sse41 = (info[2] & (1 << 19)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    sse41 = __builtin_cpu_supports("sse4.1");
+    avx2 = __builtin_cpu_supports("avx2");
+#endif
+    if (avx2 && sse41) return Level::AVX2;
+    if (sse41) return Level::SSE41;
+#endif
+    return Level::Scalar;
+}
+
+std::atomic<int> forcedLevel{-1};
+
+QImage toRgb32(const QImage &image)
+{
+    return image.format() == QImage::Format_RGB32 ? image : image.convertToFormat(QImage::Format_RGB32);
+}
+
+void prepareDst(QImage &dst, const QSize &size)
+{
+    if (dst.size() != size || dst.format() != QImage::Format_RGB32)
+        dst = QImage(size, QImage::Format_RGB32);
+}
+
+// ---------------------------------------------------------------------------
+// 가우시안 블러: 가중치 합 256 (u16 누적: 255 * 256 + 128 < 65536)
+// ---------------------------------------------------------------------------
+
+struct Kernel {
+    int radius = 0;
+    std::vector<int16_t> weights;   // 2 * radius + 1개
+};
+
+Kernel makeKernel(int ksize, double sigma)
+{
+    // cv::GaussianBlur(CV_8U)와 같은 규칙
+    if (ksize <= 0) ksize = (int(std::lround(sigma * 3 * 2 + 1)) | 1);
+    if (sigma <= 0) sigma = 0.3 * ((ksize - 1) * 0.5 - 1) + 0.8;
+    ksize = std::max(1, ksize | 1);
+
+    Kernel k;
+    k.radius = ksize / 2;
+    std::vector<double> f(ksize);
+    double sum = 0;
+    for (int i = 0; i < ksize; ++i) {
+        double x = i - k.radius;
+        f[i] = std::exp(-(x * x) / (2 * sigma * sigma));
+        sum += f[i];
+    }
+
+    k.weights.resize(ksize);
+    int total = 0;
+    for (int i = 0; i < ksize; ++i) {
+        k.weights[i] = int16_t(std::lround(f[i] / sum * 256));
+        total += k.weights[i];
+    }
+    k.weights[k.radius] += int16_t(256 - total);   // 반올림 오차는 중앙에
+    return k;
+}
+
+inline uint8_t weightedByte(int acc)
+{
+    return uint8_t((acc + 128) >> 8);
+}
+
+// 가로: pad는 좌우 radius 픽셀씩 복제된 행
+void hpassScalar(const uint32_t *pad, uint32_t *out, int x, int w, const Kernel &k)
+{
+    const int taps = int(k.weights.size());
+    for (; x < w; ++x) {
+        int acc[4] = {0, 0, 0, 0};
+        for (int t = 0; t < taps; ++t) {
+            const uint8_t *px = reinterpret_cast<const uint8_t *>(pad + x + t);
+            for (int c = 0; c < 4; ++c)
+                acc[c] += px[c] * k.weights[t];
+        }
+        uint8_t *o = reinterpret_cast<uint8_t *>(out + x);
+        for (int c = 0; c < 4; ++c)
+            o[c] = weightedByte(acc[c]);
+    }
+}
+
+// 세로: rows[t]는 (y - radius + t)행 (경계 복제), 바이트 단위 처리
+void vpassScalar(const uint8_t *const *rows, uint8_t *out, int i, int n, const Kernel &k)
+{
+    const int taps = int(k.weights.size());
+    for (; i < n; ++i) {
+        int acc = 0;
+        for (int t = 0; t < taps; ++t)
+            acc += rows[t][i] * k.weights[t];
+        out[i] = weightedByte(acc);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// 언샤프 합성: src + (src - blur) * amount, amount는 Q13 (mulhrs와 같은 반올림)
+// ---------------------------------------------------------------------------
+
+inline int mulhrs(int a, int b)
+{
+    return (a * b + 0x4000) >> 15;
+}
+
+void blendScalar(const uint8_t *src, const uint8_t *blur, uint8_t *out, int i, int n, int amountQ13)
+{
+    for (; i < n; ++i) {
+        int v = src[i] + mulhrs((src[i] - blur[i]) * 4, amountQ13);
+        out[i] = uint8_t(std::clamp(v, 0, 255));
+    }
+}
+
+// ---------------------------------------------------------------------------
+// CLAHE 보조: 밝기 Y = (29B + 150G + 77R + 128) >> 8, 적용 c' = min(255, (c * 256 * gain) >> 16)
+// ---------------------------------------------------------------------------
+
+void lumaScalar(const uint32_t *px, uint8_t *luma, int x, int w)
+{
+    for (; x < w; ++x) {
+        const uint8_t *p = reinterpret_cast<const uint8_t *>(px + x);
+        luma[x] = uint8_t((p[0] * 29 + p[1] * 150 + p[2] * 77 + 128) >> 8);
+    }
+}
+
+void gainScalar(const uint32_t *px, const uint16_t *gain, uint32_t *out, int x, int w)
+{
+    for (; x < w; ++x) {
+        const uint8_t *p = reinterpret_cast<const uint8_t *>(px + x);
+        uint8_t *o = reinterpret_cast<uint8_t *>(out + x);
+        for (int c = 0; c < 3; ++c)
+            o[c] = uint8_t(std::min<uint32_t>(255, (uint32_t(p[c]) * 256 * gain[x]) >> 16));
+        o[3] = 0xFF;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// 채널별 LUT (제자리 적용)
+// ---------------------------------------------------------------------------
+
+void lutRow(uint8_t *row, int w, const ChannelLut &lut)
+{
+    for (int x = 0; x < w; ++x, row += 4) {
+        row[0] = lut.b[row[0]];
+        row[1] = lut.g[row[1]];
+        row[2] = lut.r[row[2]];
+    }
+}
+
+#if SIMDKERNELS_X86
+
+// ---------------------------------------------------------------------------
+// SSE4.1
+// ---------------------------------------------------------------------------
+
+SIMD_TARGET_SSE41 int hpassSse41(const uint32_t *pad, uint32_t *out, int w, const Kernel &k)
+{
+    const int taps = int(k.weights.size());
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi16(128);
+    int x = 0;
+    for (; x + 4 <= w; x += 4) {
+        __m128i lo = round;
+        __m128i hi = round;
+        for (int t = 0; t < taps; ++t) {
+            __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pad + x + t));
+            __m128i wv = _mm_set1_epi16(k.weights[t]);
+            lo = _mm_add_epi16(lo, _mm_mullo_epi16(_mm_unpacklo_epi8(px, zero), wv));
+            hi = _mm_add_epi16(hi, _mm_mullo_epi16(_mm_unpackhi_epi8(px, zero), wv));
+        }
+        __m128i res = _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + x), res);
+    }
+    return x;
+}
+
+SIMD_TARGET_SSE41 int vpassSse41(const uint8_t *const *rows, uint8_t *out, int n, const Kernel &k)
+{
+    const int taps = int(k.weights.size());
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi16(128);
+    int i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i lo = round;
+        __m128i hi = round;
+        for (int t = 0; t < taps; ++t) {
+            __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rows[t] + i));
+            __m128i wv = _mm_set1_epi16(k.weights[t]);
+            lo = _mm_add_epi16(lo, _mm_mullo_epi16(_mm_unpacklo_epi8(px, zero), wv));
+            hi = _mm_add_epi16(hi, _mm_mullo_epi16(_mm_unpackhi_epi8(px, zero), wv));
+        }
+        __m128i res = _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), res);
+    }
+    return i;
+}
+
+SIMD_TARGET_SSE41 int blendSse41(const uint8_t *src, const uint8_t *blur, uint8_t *out, int n, int amountQ13)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i amount = _mm_set1_epi16(int16_t(amountQ13));
+    int i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(blur + i));
+        __m128i sLo = _mm_unpacklo_epi8(s, zero);
+        __m128i sHi = _mm_unpackhi_epi8(s, zero);
+        __m128i dLo = _mm_slli_epi16(_mm_sub_epi16(sLo, _mm_unpacklo_epi8(b, zero)), 2);
+        __m128i dHi = _mm_slli_epi16(_mm_sub_epi16(sHi, _mm_unpackhi_epi8(b, zero)), 2);
+        __m128i rLo = _mm_add_epi16(sLo, _mm_mulhrs_epi16(dLo, amount));
+        __m128i rHi = _mm_add_epi16(sHi, _mm_mulhrs_epi16(dHi, amount));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_packus_epi16(rLo, rHi));
+    }
+    return i;
+}
+
+SIMD_TARGET_SSE41 int lumaSse41(const uint32_t *px, uint8_t *luma, int w)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i coeff = _mm_setr_epi16(29, 150, 77, 0, 29, 150, 77, 0);
+    const __m128i round = _mm_set1_epi32(128);
+    int x = 0;
+    for (; x + 4 <= w; x += 4) {
+        __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i *>(px + x));
+        __m128i a = _mm_madd_epi16(_mm_unpacklo_epi8(p, zero), coeff);   // [p0 BG, p0 RA, p1 BG, p1 RA]
+        __m128i b = _mm_madd_epi16(_mm_unpackhi_epi8(p, zero), coeff);
+        __m128i y = _mm_srli_epi32(_mm_add_epi32(_mm_hadd_epi32(a, b), round), 8);
+        y = _mm_packus_epi16(_mm_packus_epi32(y, y), zero);
+        const int packed = _mm_cvtsi128_si32(y);
+        std::memcpy(luma + x, &packed, 4);
+    }
+    return x;
+}
+
+SIMD_TARGET_SSE41 int gainSse41(const uint32_t *px, const uint16_t *gain, uint32_t *out, int w)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i max = _mm_set1_epi16(255);
+    const __m128i alpha = _mm_set1_epi32(int(0xFF000000));
+    int x = 0;
+    for (; x + 4 <= w; x += 4) {
+        __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i *>(px + x));
+        __m128i g = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(gain + x));
+        g = _mm_unpacklo_epi16(g, g);                 // g0 g0 g1 g1 g2 g2 g3 g3
+        __m128i gLo = _mm_unpacklo_epi32(g, g);       // g0 x4, g1 x4
+        __m128i gHi = _mm_unpackhi_epi32(g, g);       // g2 x4, g3 x4
+        __m128i lo = _mm_mulhi_epu16(_mm_slli_epi16(_mm_unpacklo_epi8(p, zero), 8), gLo);
+        __m128i hi = _mm_mulhi_epu16(_mm_slli_epi16(_mm_unpackhi_epi8(p, zero), 8), gHi);
+        lo = _mm_min_epu16(lo, max);
+        hi = _mm_min_epu16(hi, max);
+        __m128i res = _mm_or_si128(_mm_packus_epi16(lo, hi), alpha);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + x), res);
+    }
+    return x;
+}
+
+// ---------------------------------------------------------------------------
+// AVX2 (unpack/pack가 128비트 레인 단위지만 쌍으로 쓰므로 순서 유지)
+// ---------------------------------------------------------------------------
+
+SIMD_TARGET_AVX2 int hpassAvx2(const uint32_t *pad, uint32_t *out, int w, const Kernel &k)
+{
+    const int taps = int(k.weights.size());
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i round = _mm256_set1_epi16(128);
+    int x = 0;
+    for (; x + 8 <= w; x += 8) {
+        __m256i lo = round;
+        __m256i hi = round;
+        for (int t = 0; t < taps; ++t) {
+            __m256i px = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pad + x + t));
+            __m256i wv = _mm256_set1_epi16(k.weights[t]);
+            lo = _mm256_add_epi16(lo, _mm256_mullo_epi16(_mm256_unpacklo_epi8(px, zero), wv));
+            hi = _mm256_add_epi16(hi, _mm256_mullo_epi16(_mm256_unpackhi_epi8(px, zero), wv));
+        }
+        __m256i res = _mm256_packus_epi16(_mm256_srli_epi16(lo, 8), _mm256_srli_epi16(hi, 8));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + x), res);
+    }
+    return x;
+}
+
+SIMD_TARGET_AVX2 int vpassAvx2(const uint8_t *const *rows, uint8_t *out, int n, const Kernel &k)
+{
+    const int taps = int(k.weights.size());
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i round = _mm256_set1_epi16(128);
+    int i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i lo = round;
+        __m256i hi = round;
+        for (int t = 0; t < taps; ++t) {
+            __m256i px = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rows[t] + i));
+            __m256i wv = _mm256_set1_epi16(k.weights[t]);
+            lo = _mm256_add_epi16(lo, _mm256_mullo_epi16(_mm256_unpacklo_epi8(px, zero), wv));
+            hi = _mm256_add_epi16(hi, _mm256_mullo_epi16(_mm256_unpackhi_epi8(px, zero), wv));
+        }
+        __m256i res = _mm256_packus_epi16(_mm256_srli_epi16(lo, 8), _mm256_srli_epi16(hi, 8));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), res);
+    }
+    return i;
+}
+
+SIMD_TARGET_AVX2 int blendAvx2(const uint8_t *src, const uint8_t *blur, uint8_t *out, int n, int amountQ13)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i amount = _mm256_set1_epi16(int16_t(amountQ13));
+    int i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(blur + i));
+        __m256i sLo = _mm256_unpacklo_epi8(s, zero);
+        __m256i sHi = _mm256_unpackhi_epi8(s, zero);
+        __m256i dLo = _mm256_slli_epi16(_mm256_sub_epi16(sLo, _mm256_unpacklo_epi8(b, zero)), 2);
+        __m256i dHi = _mm256_slli_epi16(_mm256_sub_epi16(sHi, _mm256_unpackhi_epi8(b, zero)), 2);
+        __m256i rLo = _mm256_add_epi16(sLo, _mm256_mulhrs_epi16(dLo, amount));
+        __m256i rHi = _mm256_add_epi16(sHi, _mm256_mulhrs_epi16(dHi, amount));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_packus_epi16(rLo, rHi));
+    }
+    return i;
+}
+
+#endif // SIMDKERNELS_X86
+
+// 단계별 분기 (각 SIMD 함수는 처리한 개수를 돌려주고, 나머지는 스칼라)
+void hpass(Level level, const uint32_t *pad, uint32_t *out, int w, const Kernel &k)
+{
+    int x = 0;
+#if SIMDKERNELS_X86
+    if (level == Level::AVX2) x = hpassAvx2(pad, out, w, k);
+    else if (level == Level::SSE41) x = hpassSse41(pad, out, w, k);
+#else
+    Q_UNUSED(level);
+#endif
+    hpassScalar(pad, out, x, w, k);
+}
+
+void vpass(Level level, const uint8_t *const *rows, uint8_t *out, int n, const Kernel &k)
+{
+    int i = 0;
+#if SIMDKERNELS_X86
+    if (level == Level::AVX2) i = vpassAvx2(rows, out, n, k);
+    else if (level == Level::SSE41) i = vpassSse41(rows, out, n, k);
+#else
+    Q_UNUSED(level);
+#endif
+    vpassScalar(rows, out, i, n, k);
+}
+
+void blend(Level level, const uint8_t *src, const uint8_t *blur, uint8_t *out, int n, int amountQ13)
+{
+    int i = 0;
+#if SIMDKERNELS_X86
+    if (level == Level::AVX2) i = blendAvx2(src, blur, out, n, amountQ13);
+    else if (level == Level::SSE41) i = blendSse41(src, blur, out, n, amountQ13);
+#else
+    Q_UNUSED(level);
+#endif
+    blendScalar(src, blur, out, i, n, amountQ13);
+}
+
+// 밝기 계산/적용은 메모리 대역폭이 병목이라 AVX2에서도 SSE4.1 경로 사용
+void luma(Level level, const uint32_t *px, uint8_t *out, int w)
+{
+    int x = 0;
+#if SIMDKERNELS_X86
+    if (level != Level::Scalar) x = lumaSse41(px, out, w);
+#else
+    Q_UNUSED(level);
+#endif
+    lumaScalar(px, out, x, w);
+}
+
+void applyGain(Level level, const uint32_t *px, const uint16_t *gain, uint32_t *out, int w)
+{
+    int x = 0;
+#if SIMDKERNELS_X86
+    if (level != Level::Scalar) x = gainSse41(px, gain, out, w);
+#else
+    Q_UNUSED(level);
+#endif
+    gainScalar(px, gain, out, x, w);
+}
+
+// cv::CLAHE와 같은 방식의 타일 LUT (클립 초과분은 전체 구간에 고르게 재분배)
+void buildTileLut(const int *hist, int area, double clipLimit, uint8_t *lut)
+{
+    int clipped[256];
+    std::copy(hist, hist + 256, clipped);
+
+    const int limit = std::max(1, int(clipLimit * area / 256));
+    int excess = 0;
+    for (int i = 0; i < 256; ++i) {
+        if (clipped[i] > limit) {
+            excess += clipped[i] - limit;
+            clipped[i] = limit;
+        }
+    }
+    const int batch = excess / 256;
+    const int residual = excess - batch * 256;
+    for (int i = 0; i < 256; ++i)
+        clipped[i] += batch;
+    if (residual > 0) {
+        const int step = std::max(256 / residual, 1);
+        for (int i = 0, left = residual; i < 256 && left > 0; i += step, --left)
+            ++clipped[i];
+    }
+
+    const double scale = 255.0 / std::max(1, area);
+    int cdf = 0;
+    for (int i = 0; i < 256; ++i) {
+        cdf += clipped[i];
+        lut[i] = uint8_t(std::min(255L, std::lround(cdf * scale)));
+    }
+}
+
+} // namespace
+
+Level detectedLevel()
+{
+    static const Level level = detectLevel();
+    return level;
+}
+
+Level activeLevel()
+{
+    const int forced = forcedLevel.load(std::memory_order_relaxed);
+    return forced < 0 ? detectedLevel() : Level(forced);
+}
+
+void forceLevel(Level level)
+{
+    forcedLevel.store(int(std::min(level, detectedLevel())), std::memory_order_relaxed);
+}
+
+const char *levelName(Level level)
+{
+    switch (level) {
+    case Level::AVX2: return "AVX2";
+    case Level::SSE41: return "SSE4.1";
+    default: return "Scalar";
+    }
+}
+
+void gaussianBlur(const QImage &srcImage, QImage &dst, int ksize, double sigma, const ChannelLut *post)
+{
+    const QImage src = toRgb32(srcImage);
+    if (src.isNull()) {
+        dst = QImage();
+        return;
+    }
+
+    const Level level = activeLevel();
+    const Kernel k = makeKernel(ksize, sigma);
+    const int w = src.width();
+    const int h = src.height();
+    const int r = k.radius;
+
+    // 1) 가로 → tmp (행마다 경계 복제 버퍼)
+    QImage tmp(src.size(), QImage::Format_RGB32);
+    std::vector<uint32_t> pad(size_t(w + 2 * r));
+    for (int y = 0; y < h; ++y) {
+        const uint32_t *in = reinterpret_cast<const uint32_t *>(src.constScanLine(y));
+        std::fill(pad.begin(), pad.begin() + r, in[0]);
+        std::memcpy(pad.data() + r, in, size_t(w) * 4);
+        std::fill(pad.begin() + r + w, pad.end(), in[w - 1]);
+        hpass(level, pad.data(), reinterpret_cast<uint32_t *>(tmp.scanLine(y)), w, k);
+    }
+
+    // 2) 세로 → dst (src와 같은 이미지여도 tmp만 읽으므로 안전)
+    prepareDst(dst, src.size());
+    std::vector<const uint8_t *> rows(k.weights.size());
+    for (int y = 0; y < h; ++y) {
+        for (int t = 0; t <= 2 * r; ++t)
+            rows[t] = tmp.constScanLine(std::clamp(y - r + t, 0, h - 1));
+        uint8_t *out = dst.scanLine(y);
+        vpass(level, rows.data(), out, w * 4, k);
+        if (post) lutRow(out, w, *post);
+    }
+}
+
+void unsharpBlend(const QImage &srcImage, const QImage &blurredImage, QImage &dst, double alpha,
+                  const ChannelLut *post)
+{
+    const QImage src = toRgb32(srcImage);
+    const QImage blurred = toRgb32(blurredImage);
+    if (src.isNull() || blurred.size() != src.size()) {
+        dst = src;
+        if (post && !dst.isNull()) applyLut(dst, dst, *post);
+        return;
+    }
+
+    // src*alpha + blur*(1-alpha) = src + (src - blur)*(alpha - 1), 배율은 Q13 (|amount| < 4)
+    const int amountQ13 = std::clamp(int(std::lround((alpha - 1.0) * 8192)), -32767, 32767);
+    const Level level = activeLevel();
+
+    prepareDst(dst, src.size());
+    const int n = src.width() * 4;
+    for (int y = 0; y < src.height(); ++y) {
+        uint8_t *out = dst.scanLine(y);
+        blend(level, src.constScanLine(y), blurred.constScanLine(y), out, n, amountQ13);
+        if (post) lutRow(out, src.width(), *post);
+    }
+}
+
+void claheLuma(const QImage &srcImage, QImage &dst, double clipLimit, int tiles, const ChannelLut *post)
+{
+    const QImage src = toRgb32(srcImage);
+    if (src.isNull()) {
+        dst = QImage();
+        return;
+    }
+
+    const Level level = activeLevel();
+    const int w = src.width();
+    const int h = src.height();
+    tiles = std::clamp(tiles, 1, std::min(w, h));
+    const int tileW = (w + tiles - 1) / tiles;
+    const int tileH = (h + tiles - 1) / tiles;
+
+    // 1) 밝기 평면 + 타일 히스토그램
+    std::vector<uint8_t> Y(size_t(w) * h);
+    std::vector<int> hist(size_t(tiles) * tiles * 256, 0);
+    for (int y = 0; y < h; ++y) {
+        uint8_t *row = Y.data() + size_t(y) * w;
+        luma(level, reinterpret_cast<const uint32_t *>(src.constScanLine(y)), row, w);
+        int *histRow = hist.data() + size_t(y / tileH) * tiles * 256;
+        for (int x = 0; x < w; ++x)
+            ++histRow[(x / tileW) * 256 + row[x]];
+    }
+
+    // 2) 타일별 LUT
+    std::vector<uint8_t> luts(size_t(tiles) * tiles * 256);
+    for (int ty = 0; ty < tiles; ++ty) {
+        for (int tx = 0; tx < tiles; ++tx) {
+            const int tileIndex = ty * tiles + tx;
+            const int area = (std::min(w, (tx + 1) * tileW) - tx * tileW) *
+                             (std::min(h, (ty + 1) * tileH) - ty * tileH);
+            buildTileLut(hist.data() + size_t(tileIndex) * 256, area, clipLimit,
+                         luts.data() + size_t(tileIndex) * 256);
+        }
+    }
+
+    // 3) 타일 중심 기준 쌍선형 보간 → 픽셀별 이득(Q8), 4) RGB 적용
+    std::vector<int> tx1(w), tx2(w);
+    std::vector<float> xa(w);
+    for (int x = 0; x < w; ++x) {
+        const float txf = float(x) / tileW - 0.5f;
+        const int t1 = int(std::floor(txf));
+        xa[x] = txf - t1;
+        tx1[x] = std::max(t1, 0);
+        tx2[x] = std::min(t1 + 1, tiles - 1);
+    }
+
+    prepareDst(dst, src.size());
+    std::vector<uint16_t> gain(w);
+    for (int y = 0; y < h; ++y) {
+        const float tyf = float(y) / tileH - 0.5f;
+        const int t1 = int(std::floor(tyf));
+        const float ya = tyf - t1;
+        const uint8_t *lutTop = luts.data() + size_t(std::max(t1, 0)) * tiles * 256;
+        const uint8_t *lutBottom = luts.data() + size_t(std::min(t1 + 1, tiles - 1)) * tiles * 256;
+        const uint8_t *row = Y.data() + size_t(y) * w;
+
+        for (int x = 0; x < w; ++x) {
+            const int v = row[x];
+            const float top = lutTop[tx1[x] * 256 + v] * (1 - xa[x]) + lutTop[tx2[x] * 256 + v] * xa[x];
+            const float bottom = lutBottom[tx1[x] * 256 + v] * (1 - xa[x]) + lutBottom[tx2[x] * 256 + v] * xa[x];
+            const float mapped = top * (1 - ya) + bottom * ya;
+            gain[x] = v == 0 ? 256 : uint16_t(std::min(65535.0f, mapped * 256 / v + 0.5f));
+        }
+        uint8_t *out = dst.scanLine(y);
+        applyGain(level, reinterpret_cast<const uint32_t *>(src.constScanLine(y)), gain.data(),
+                  reinterpret_cast<uint32_t *>(out), w);
+        if (post) lutRow(out, w, *post);
+    }
+}
+
+void applyLut(const QImage &srcImage, QImage &dst, const ChannelLut &lut)
+{
+    if (&srcImage == &dst && dst.format() == QImage::Format_RGB32) {
+        for (int y = 0; y < dst.height(); ++y)
+            lutRow(dst.scanLine(y), dst.width(), lut);
+        return;
+    }
+
+    const QImage src = toRgb32(srcImage);
+    prepareDst(dst, src.size());
+    const size_t bytes = size_t(src.width()) * 4;
+    for (int y = 0; y < src.height(); ++y) {
+        uint8_t *out = dst.scanLine(y);
+        std::memcpy(out, src.constScanLine(y), bytes);
+        lutRow(out, src.width(), lut);
+    }
+}
+
+}
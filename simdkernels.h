@@ -0,0 +1,46 @@
+#ifndef SIMDKERNELS_H
+#define SIMDKERNELS_H
+
+#include <QImage>
+
+#include <cstdint>
+
+// ✅ ImageEnhancer 연산의 SIMD 구현 (cv::Mat 변환 없이 QImage 스캔라인을 직접 처리)
+//    - 입력/출력 형식: QImage::Format_RGB32 (다른 형식은 변환 후 처리, 알파는 0xFF 유지)
+//    - 실행 시 CPU를 확인해서 AVX2 / SSE4.1 / 스칼라 중 선택
+//    - 가중치는 고정소수점(합 256)이라 단계별 결과가 비트 단위로 동일
+namespace SimdKernels {
+
+enum class Level { Scalar, SSE41, AVX2 };
+
+Level detectedLevel();          // CPU가 지원하는 최고 단계
+Level activeLevel();            // 실제 사용 단계
+void forceLevel(Level level);   // 벤치마크/비교용 (지원 단계보다 높게는 불가)
+const char *levelName(Level level);
+
+// 채널별 8비트 LUT (RGB32 메모리 순서: B, G, R / 알파는 그대로)
+struct ChannelLut {
+    uint8_t b[256];
+    uint8_t g[256];
+    uint8_t r[256];
+};
+
+// 아래 함수의 post: 결과 행을 쓰자마자 같은 행에 LUT 적용 (별도 패스 없이 융합)
+
+// 분리형 가우시안 블러 (ksize/sigma 규칙은 cv::GaussianBlur와 동일, 경계는 복제)
+void gaussianBlur(const QImage &src, QImage &dst, int ksize, double sigma, const ChannelLut *post = nullptr);
+
+// 언샤프 합성: dst = src * alpha + blurred * (1 - alpha)  (cv::addWeighted 샤프닝 식)
+void unsharpBlend(const QImage &src, const QImage &blurred, QImage &dst, double alpha,
+                  const ChannelLut *post = nullptr);
+
+// 밝기(Y) 채널 CLAHE 후 RGB 비율을 유지하며 적용 (Lab L 채널 CLAHE 근사)
+//    밝기 계산과 최종 적용은 SIMD, 타일 히스토그램/보간은 스칼라
+void claheLuma(const QImage &src, QImage &dst, double clipLimit, int tiles = 8, const ChannelLut *post = nullptr);
+
+// LUT 단독 적용 (dst가 src와 같은 이미지여도 됨)
+void applyLut(const QImage &src, QImage &dst, const ChannelLut &lut);
+
+}
+
+#endif // SIMDKERNELS_H
@@ -0,0 +1,156 @@
+#include "eventring.h"
+#include "eventstore.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtTest>
+
+// ✅ 이벤트 보관소 단위 테스트 (링 사본 / 같은 시각 병합 순서 / 검색 / 잘린 저장소 꼬리)
+class EventRingTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void snapshotIsolatedFromAppend();
+    void snapshotSurvivesEviction();
+    void mergeKeepsOrderForEqualTimestamps();
+    void searchIgnoresSpacingAndNumberPrefixes();
+    void storeDropsTruncatedTail();
+
+private:
+    static constexpr qint64 dayMs = 24LL * 3600 * 1000;
+
+    static LogEntry entry(const QString &event, const QDateTime &time, const QString &details = QString()) {
+        return LogEntry{"cam-1", "PPE", event, time.toString("yyyy-MM-dd HH:mm:ss"), QString(), details};
+    }
+    static QStringList events(const EventSnapshot &snapshot) {
+        QStringList result;
+        for (quint64 seq = snapshot.firstSeq(); seq < snapshot.endSeq(); ++seq)
+            result.append(snapshot.at(seq).eventText());
+        return result;
+    }
+    static QStringList search(const EventRing &ring, const QString &text) {
+        EventQuery query;
+        query.text = text;
+        const EventSnapshot snapshot = ring.snapshot();
+        QStringList result;
+        ring.plan(query).run(snapshot, 256, 256, [&](const QVector<quint64> &seqs) {
+            for (quint64 seq : seqs)
+                result.append(snapshot.at(seq).eventText());
+            return true;
+        });
+        return result;
+    }
+};
+
+void EventRingTest::snapshotIsolatedFromAppend()
+{
+    EventRing ring(100000, dayMs);
+    const QDateTime base = QDateTime::currentDateTime().addSecs(-7200);
+    const int count = EventSnapshot::chunkSize + 10;   // 덩어리 경계를 넘김
+    for (int i = 0; i < count; ++i)
+        ring.append(entry(QString::number(i), base.addSecs(i)));
+
+    const EventSnapshot snapshot = ring.snapshot();
+    const QStringList before = events(snapshot);
+
+    // 꼬리 추가 + 늦게 도착한 항목(중간 삽입) + 병합 → 공유 중인 덩어리를 고치는 경로 전부
+    ring.append(entry("tail", base.addSecs(count)));
+    ring.append(entry("late", base.addSecs(5)));
+    ring.merge(QVector<LogEntry>{entry("merged", base.addSecs(EventSnapshot::chunkSize - 1))});
+
+    QCOMPARE(snapshot.size(), count);
+    QCOMPARE(events(snapshot), before);
+    QCOMPARE(ring.size(), count + 3);
+    QVERIFY(ring.layoutRevision() != snapshot.layoutRevision());
+    QCOMPARE(ring.at(ring.firstSeq() + 6).eventText(), QString("late"));
+}
+
+void EventRingTest::snapshotSurvivesEviction()
+{
+    EventRing ring(EventSnapshot::chunkSize, dayMs);
+    const QDateTime base = QDateTime::currentDateTime().addSecs(-3 * 3600);
+    for (int i = 0; i < EventSnapshot::chunkSize; ++i)
+        ring.append(entry(QString::number(i), base.addSecs(i)));
+
+    const EventSnapshot snapshot = ring.snapshot();
+    const QStringList before = events(snapshot);
+
+    // 한도만큼 더 넣으면 첫 덩어리 전체가 밀려남 (사본은 그 덩어리를 계속 들고 있음)
+    for (int i = 0; i < EventSnapshot::chunkSize; ++i)
+        ring.append(entry(QString("new %1").arg(i), base.addSecs(EventSnapshot::chunkSize + i)));
+
+    QCOMPARE(ring.size(), EventSnapshot::chunkSize);
+    QVERIFY(!ring.contains(snapshot.firstSeq()));
+    QCOMPARE(events(snapshot), before);
+}
+
+void EventRingTest::mergeKeepsOrderForEqualTimestamps()
+{
+    EventRing ring(1000, dayMs);
+    const QDateTime t = QDateTime::currentDateTime().addSecs(-60);
+    ring.append(entry("existing", t));
+    ring.append(entry("later", t.addSecs(1)));
+
+    // 같은 시각: 기존 항목 → run 번호 순 → run 안에서는 원래 순서
+    std::vector<QVector<EventRecord>> runs;
+    runs.push_back({EventRecord::fromEntry(entry("run0-a", t), 0), EventRecord::fromEntry(entry("run0-b", t), 0)});
+    runs.push_back({EventRecord::fromEntry(entry("run1-a", t), 0)});
+    ring.mergeRuns(std::move(runs));
+
+    // 늦게 도착한 실시간 이벤트도 같은 시각 항목들 뒤
+    ring.append(entry("late", t));
+
+    QCOMPARE(events(ring.snapshot()), QStringList({"existing", "run0-a", "run0-b", "run1-a", "late", "later"}));
+}
+
+void EventRingTest::searchIgnoresSpacingAndNumberPrefixes()
+{
+    EventRing ring(1000, dayMs);
+    const QDateTime t = QDateTime::currentDateTime().addSecs(-60);
+    ring.append(entry("⛑️ 헬멧 미착용 감지", t, "👷 3명 | ⛑️ 1명 | 🦺 3명 | 신뢰도: 0.91"));
+    ring.append(entry("🚷 무단 침입 감지 (13명)", t.addSecs(1)));
+    ring.append(entry("🚷 무단 침입 감지 (3명)", t.addSecs(2)));
+
+    QCOMPARE(search(ring, "헬멧미착용"), QStringList({"⛑️ 헬멧 미착용 감지"}));
+    QCOMPARE(search(ring, "침입 3명"), QStringList({"🚷 무단 침입 감지 (3명)"}));
+    QCOMPARE(search(ring, "13명"), QStringList({"🚷 무단 침입 감지 (13명)"}));
+    QCOMPARE(search(ring, "신뢰도"), QStringList({"⛑️ 헬멧 미착용 감지"}));
+    QVERIFY(search(ring, "없는말").isEmpty());
+}
+
+void EventRingTest::storeDropsTruncatedTail()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QDateTime t = QDateTime::currentDateTime().addSecs(-60);
+    {
+        EventStore store(dir.path());
+        QVERIFY(store.isOpen());
+        store.append(QVector<LogEntry>{entry("a", t), entry("b", t.addSecs(1)), entry("c", t.addSecs(2))});
+    }
+
+    // 기록 중 종료: 마지막 본문이 잘리고 인덱스에는 반쪽 레코드가 남음
+    QFile data(dir.filePath("000001.seg"));
+    QVERIFY(data.resize(data.size() - 1));
+    QFile index(dir.filePath("000001.idx"));
+    QVERIFY(index.open(QIODevice::Append));
+    index.write(QByteArray(7, '\xff'));
+    index.close();
+
+    {
+        EventStore store(dir.path());
+        QCOMPARE(store.count(), qint64(2));
+        store.append(entry("d", t.addSecs(3)));   // 잘라낸 자리부터 이어서 기록
+    }
+
+    EventStore store(dir.path());
+    QStringList stored;
+    for (const EventRecord &record : store.readNewest(10))
+        stored.append(record.eventText());
+    QCOMPARE(stored, QStringList({"a", "b", "d"}));
+}
+
+QTEST_GUILESS_MAIN(EventRingTest)
+#include "eventringtest.moc"
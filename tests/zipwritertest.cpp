@@ -0,0 +1,107 @@
+#include "zipwriter.h"
+
+#include <QBuffer>
+#include <QRegularExpression>
+#include <QtEndian>
+#include <QtTest>
+
+// ✅ ZIP 작성기 단위 테스트 (로컬 헤더 ↔ 중앙 디렉터리 ↔ 끝 레코드 오프셋이 서로 맞는지)
+class ZipWriterTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void crcMatchesKnownValue();
+    void centralDirectoryPointsAtLocalHeaders();
+    void failsAfterDeviceError();
+
+private:
+    static quint16 get16(const QByteArray &bytes, qint64 at) {
+        return qFromLittleEndian<quint16>(bytes.constData() + at);
+    }
+    static quint32 get32(const QByteArray &bytes, qint64 at) {
+        return qFromLittleEndian<quint32>(bytes.constData() + at);
+    }
+};
+
+void ZipWriterTest::crcMatchesKnownValue()
+{
+    QCOMPARE(ZipWriter::crc32(0, "hello", 5), quint32(0x3610A686));
+
+    // 나눠서 계산해도 같은 값 (파일 항목은 블록 단위로 이어서 계산)
+    QCOMPARE(ZipWriter::crc32(ZipWriter::crc32(0, "hel", 3), "lo", 2), quint32(0x3610A686));
+}
+
+void ZipWriterTest::centralDirectoryPointsAtLocalHeaders()
+{
+    // 복사 블록(256KB)보다 큰 장치 항목 + 한글 이름 항목
+    QByteArray large(300 * 1024, '\0');
+    for (int i = 0; i < large.size(); ++i)
+        large[i] = char(i * 31 + 7);
+    QBuffer source(&large);
+    QVERIFY(source.open(QIODevice::ReadOnly));
+
+    const QList<QPair<QString, QByteArray>> files{
+        {"events.csv", "time,camera\r\n"},
+        {"images/12_헬멧.jpg", large},
+        {"missing_images.txt", QByteArray()},
+    };
+
+    QByteArray archive;
+    QBuffer output(&archive);
+    QVERIFY(output.open(QIODevice::WriteOnly));
+    ZipWriter zip(&output);
+    QVERIFY(zip.addFile(files[0].first, files[0].second));
+    QVERIFY(zip.addFile(files[1].first, &source));
+    QVERIFY(zip.addFile(files[2].first, files[2].second));
+    QVERIFY(zip.finish());
+    output.close();
+
+    // 끝 레코드 (주석 없음 → 마지막 22바이트)
+    const qint64 end = archive.size() - 22;
+    QCOMPARE(get32(archive, end), quint32(0x06054b50));
+    QCOMPARE(get16(archive, end + 8), quint16(files.size()));
+    QCOMPARE(get16(archive, end + 10), quint16(files.size()));
+    const quint32 directorySize = get32(archive, end + 12);
+    const quint32 directoryOffset = get32(archive, end + 16);
+    QCOMPARE(qint64(directoryOffset) + directorySize, end);
+
+    qint64 at = directoryOffset;
+    for (const auto &file : files) {
+        const QByteArray name = file.first.toUtf8();
+        const quint32 crc = ZipWriter::crc32(0, file.second.constData(), file.second.size());
+
+        QCOMPARE(get32(archive, at), quint32(0x02014b50));
+        QCOMPARE(get32(archive, at + 16), crc);
+        QCOMPARE(get32(archive, at + 20), quint32(file.second.size()));
+        QCOMPARE(get32(archive, at + 24), quint32(file.second.size()));
+        const quint16 nameSize = get16(archive, at + 28);
+        QCOMPARE(archive.mid(at + 46, nameSize), name);
+        const quint32 local = get32(archive, at + 42);
+
+        // 중앙 디렉터리의 오프셋 → 같은 이름/CRC의 로컬 헤더, 그 바로 뒤가 원본 그대로
+        QCOMPARE(get32(archive, local), quint32(0x04034b50));
+        QCOMPARE(get32(archive, local + 14), crc);
+        QCOMPARE(get16(archive, local + 26), quint16(name.size()));
+        QCOMPARE(archive.mid(local + 30, name.size()), name);
+        QCOMPARE(archive.mid(local + 30 + name.size(), file.second.size()), file.second);
+
+        at += 46 + nameSize;
+    }
+    QCOMPARE(at, end);
+}
+
+void ZipWriterTest::failsAfterDeviceError()
+{
+    QByteArray archive;
+    QBuffer output(&archive);
+    QVERIFY(output.open(QIODevice::ReadOnly));   // 쓰기 불가 장치
+    ZipWriter zip(&output);
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("QIODevice::write"));
+    QVERIFY(!zip.addFile("a.txt", "data"));
+    QVERIFY(!zip.errorString().isEmpty());
+    QVERIFY(!zip.finish());
+}
+
+QTEST_GUILESS_MAIN(ZipWriterTest)
+#include "zipwritertest.moc"
@@ -0,0 +1,62 @@
+#include "thumbnailprefetcher.h"
+#include "eventlogmodel.h"
+
+#include <QListView>
+#include <QScrollBar>
+#include <QEvent>
+
+namespace {
+constexpr int kDebounceMs = 50;
+}
+
+ThumbnailPrefetcher::ThumbnailPrefetcher(QListView *view, EventLogModel *model, int marginRows, QObject *parent)
+    : QObject(parent), view(view), model(model), marginRows(marginRows)
+{
+    debounce.setSingleShot(true);
+    debounce.setInterval(kDebounceMs);
+    connect(&debounce, &QTimer::timeout, this, &ThumbnailPrefetcher::updateRange);
+
+    connect(view->verticalScrollBar(), &QScrollBar::valueChanged, this, &ThumbnailPrefetcher::schedule);
+    connect(view->verticalScrollBar(), &QScrollBar::rangeChanged, this, &ThumbnailPrefetcher::schedule);
+    connect(model, &QAbstractItemModel::rowsInserted, this, &ThumbnailPrefetcher::schedule);
+    connect(model, &QAbstractItemModel::rowsRemoved, this, &ThumbnailPrefetcher::schedule);
+    connect(model, &QAbstractItemModel::modelReset, this, &ThumbnailPrefetcher::schedule);
+
+    view->viewport()->installEventFilter(this);   // 크기 변경 / 처음 표시
+}
+
+bool ThumbnailPrefetcher::eventFilter(QObject *watched, QEvent *event)
+{
+    if (watched == view->viewport() &&
+        (event->type() == QEvent::Resize || event->type() == QEvent::Show ||
+         event->type() == QEvent::Hide)) {
+        schedule();
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void ThumbnailPrefetcher::schedule()
+{
+    if (!debounce.isActive())
+        debounce.start();
+}
+
+void ThumbnailPrefetcher::updateRange()
+{
+    const int count = model->rowCount();
+    if (count == 0) return;
+
+    // 숨겨진 상태(최소화 등)면 아무것도 요청하지 않음
+    if (!view->isVisible()) {
+        model->setVisibleRange(0, -1, 0);
+        return;
+    }
+
+    const QRect area = view->viewport()->rect();
+    QModelIndex top = view->indexAt(area.topLeft());
+    QModelIndex bottom = view->indexAt(QPoint(area.left(), area.bottom()));
+
+    int first = top.isValid() ? top.row() : 0;
+    int last = bottom.isValid() ? bottom.row() : count - 1;
+    model->setVisibleRange(first, last, marginRows);
+}
@@ -0,0 +1,32 @@
+#ifndef THUMBNAILPREFETCHER_H
+#define THUMBNAILPREFETCHER_H
+
+#include <QObject>
+#include <QTimer>
+
+class QListView;
+class EventLogModel;
+
+// ✅ 실시간 로그 뷰의 보이는 범위를 추적해서 썸네일 요청/취소를 모델에 전달
+//    스크롤·크기 변경·행 추가가 몰려도 짧게 모아서 한 번만 계산
+class ThumbnailPrefetcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    ThumbnailPrefetcher(QListView *view, EventLogModel *model, int marginRows = 3, QObject *parent = nullptr);
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    void schedule();
+    void updateRange();
+
+    QListView *view;
+    EventLogModel *model;
+    int marginRows;
+    QTimer debounce;
+};
+
+#endif // THUMBNAILPREFETCHER_H
@@ -0,0 +1,106 @@
+#include "timelinestrip.h"
+
+#include <QDateTime>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QToolTip>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr int binWidth = 3;
+}
+
+TimelineStrip::TimelineStrip(QWidget *parent)
+    : QWidget(parent)
+{
+    setFixedHeight(48);
+    setMouseTracking(true);
+    setCursor(Qt::PointingHandCursor);
+}
+
+int TimelineStrip::binCount() const
+{
+    return qMax(1, width() / binWidth);
+}
+
+void TimelineStrip::setData(qint64 fromMs, qint64 toMs, const QVector<int> &counts)
+{
+    this->fromMs = fromMs;
+    this->toMs = toMs;
+    this->counts = counts;
+    maxCount = counts.isEmpty() ? 0 : *std::max_element(counts.begin(), counts.end());
+    hoverBin = -1;
+    update();
+}
+
+int TimelineStrip::binAt(int x) const
+{
+    if (counts.isEmpty()) return -1;
+    const int bin = x * counts.size() / qMax(1, width());
+    return bin >= 0 && bin < counts.size() ? bin : -1;
+}
+
+qint64 TimelineStrip::binStart(int bin) const
+{
+    return fromMs + (toMs - fromMs) * bin / qMax(1, int(counts.size()));
+}
+
+void TimelineStrip::paintEvent(QPaintEvent *)
+{
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor("#2b2b2b"));
+    painter.setPen(QColor("#444"));
+    painter.drawRect(rect().adjusted(0, 0, -1, -1));
+    if (counts.isEmpty() || maxCount == 0) return;
+
+    // 건수가 몇 개 안 되는 칸도 보이도록 제곱근 눈금
+    const int usable = height() - 6;
+    const qreal scale = usable / std::sqrt(qreal(maxCount));
+    const qreal step = qreal(width()) / counts.size();
+    for (int i = 0; i < counts.size(); ++i) {
+        if (counts[i] == 0) continue;
+        const int h = qMax(2, int(std::sqrt(qreal(counts[i])) * scale));
+        const QRectF bar(i * step, height() - 3 - h, qMax<qreal>(1.0, step - 1), h);
+        painter.fillRect(bar, i == hoverBin ? QColor("#ffffff") : QColor("#f37321"));
+    }
+}
+
+void TimelineStrip::mousePressEvent(QMouseEvent *event)
+{
+    if (event->button() != Qt::LeftButton) return;
+    const int bin = binAt(int(event->position().x()));
+    if (bin < 0) return;
+    emit binClicked(binStart(bin), binStart(bin + 1));
+    event->accept();
+}
+
+void TimelineStrip::mouseMoveEvent(QMouseEvent *event)
+{
+    const int bin = binAt(int(event->position().x()));
+    if (bin != hoverBin) {
+        hoverBin = bin;
+        update();
+    }
+    if (bin < 0) return;
+
+    const QString format = toMs - fromMs > 24LL * 3600 * 1000 ? "MM-dd HH:mm" : "HH:mm";
+    QToolTip::showText(event->globalPosition().toPoint(),
+                       QString("%1 ~ %2\n%3건")
+                           .arg(QDateTime::fromMSecsSinceEpoch(binStart(bin)).toString(format),
+                                QDateTime::fromMSecsSinceEpoch(binStart(bin + 1)).toString(format))
+                           .arg(counts[bin]),
+                       this);
+}
+
+void TimelineStrip::leaveEvent(QEvent *)
+{
+    hoverBin = -1;
+    update();
+}
+
+void TimelineStrip::resizeEvent(QResizeEvent *)
+{
+    emit resized();
+}
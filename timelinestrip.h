@@ -0,0 +1,43 @@
+#ifndef TIMELINESTRIP_H
+#define TIMELINESTRIP_H
+
+#include <QWidget>
+#include <QVector>
+
+// ✅ 이벤트 밀도 타임라인 (왼쪽 = 오래된 쪽, 오른쪽 = 최근)
+//    칸별 건수는 밖에서 EventStats 집계로 채움, 클릭하면 그 칸의 시각 구간을 알림
+class TimelineStrip : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit TimelineStrip(QWidget *parent = nullptr);
+
+    // 현재 폭에 맞는 칸 수 (칸 폭 3px)
+    int binCount() const;
+
+    void setData(qint64 fromMs, qint64 toMs, const QVector<int> &counts);
+
+signals:
+    void binClicked(qint64 fromMs, qint64 toMs);
+    void resized();   // 칸 수가 바뀜 → 다시 집계
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void leaveEvent(QEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+
+private:
+    int binAt(int x) const;
+    qint64 binStart(int bin) const;
+
+    qint64 fromMs = 0;
+    qint64 toMs = 0;
+    QVector<int> counts;
+    int maxCount = 0;
+    int hoverBin = -1;
+};
+
+#endif // TIMELINESTRIP_H
@@ -0,0 +1,71 @@
+#include "tonelut.h"
+
+#include <QCache>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <algorithm>
+#include <cmath>
+
+namespace ToneLut {
+
+namespace {
+
+// 자주 쓰는 설정 (카메라 기본 감마 보정, 밝기/대비 슬라이더 기본 단계)
+struct Preset {
+    int gammaPermille;
+    int brightness;
+    int contrast;
+    const Table *table;
+};
+
+const Preset kPresets[] = {
+    {500, 0, 0, &kTable<500, 0, 0>},
+    {800, 0, 0, &kTable<800, 0, 0>},
+    {1200, 0, 0, &kTable<1200, 0, 0>},
+    {1500, 0, 0, &kTable<1500, 0, 0>},
+    {1800, 0, 0, &kTable<1800, 0, 0>},
+    {2200, 0, 0, &kTable<2200, 0, 0>},
+    {1000, -20, 0, &kTable<1000, -20, 0>},
+    {1000, -10, 0, &kTable<1000, -10, 0>},
+    {1000, 10, 0, &kTable<1000, 10, 0>},
+    {1000, 20, 0, &kTable<1000, 20, 0>},
+    {1000, 0, -20, &kTable<1000, 0, -20>},
+    {1000, 0, -10, &kTable<1000, 0, -10>},
+    {1000, 0, 10, &kTable<1000, 0, 10>},
+    {1000, 0, 20, &kTable<1000, 0, 20>},
+};
+
+// 그 외 설정: 계산 결과 캐시 (표 1개 256바이트)
+QMutex cacheMutex;
+QCache<quint64, Table> cache(256);
+
+}
+
+Table lookup(double gamma, int brightness, int contrast)
+{
+    const int gammaPermille = int(std::clamp(std::lround(gamma * 1000), 50L, 100000L));
+    brightness = std::clamp(brightness, -100, 100);
+    contrast = std::clamp(contrast, -100, 100);
+
+    for (const Preset &preset : kPresets) {
+        if (preset.gammaPermille == gammaPermille && preset.brightness == brightness
+            && preset.contrast == contrast)
+            return *preset.table;
+    }
+
+    const quint64 key = (quint64(gammaPermille) << 16) | (quint64(brightness + 100) << 8) | quint64(contrast + 100);
+    {
+        QMutexLocker locker(&cacheMutex);
+        if (const Table *cached = cache.object(key))
+            return *cached;
+    }
+
+    // 계산은 잠금 밖에서 (동시에 같은 설정을 요청하면 양쪽이 계산해도 결과는 같음)
+    const Table table = make(gammaPermille, brightness, contrast);
+    QMutexLocker locker(&cacheMutex);
+    cache.insert(key, new Table(table));
+    return table;
+}
+
+}
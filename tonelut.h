@@ -0,0 +1,95 @@
+#ifndef TONELUT_H
+#define TONELUT_H
+
+#include <cstdint>
+
+// ✅ 톤 보정(감마 / 밝기 / 대비) 8비트 LUT
+//    - 표 계산은 constexpr → 자주 쓰는 설정은 컴파일 시 생성 (kTable)
+//    - 그 외 설정은 처음 요청될 때 한 번 계산해서 캐시 (lookup)
+//    - 컴파일 시/실행 시 같은 함수로 계산하므로 결과가 항상 동일
+//    - 감마는 0.001 단위로 맞춤 (파이프라인 캐시 키와 같은 정밀도)
+namespace ToneLut {
+
+struct Table {
+    uint8_t v[256];
+};
+
+namespace detail {
+
+constexpr double kLn2 = 0.69314718055994530942;
+
+// std::log / std::pow는 constexpr가 아니라서 급수로 직접 계산 (오차 1e-13 이하)
+constexpr double ln(double x)
+{
+    int k = 0;
+    while (x < 0.5) { x *= 2; --k; }
+    while (x > 1.0) { x /= 2; ++k; }
+    // ln x = 2 * atanh((x - 1) / (x + 1)), |z| <= 1/3
+    const double z = (x - 1) / (x + 1);
+    const double z2 = z * z;
+    double term = z;
+    double sum = 0;
+    for (int n = 1; n < 26; n += 2) {
+        sum += term / n;
+        term *= z2;
+    }
+    return 2 * sum + k * kLn2;
+}
+
+constexpr double exp(double x)
+{
+    // x = n * ln2 + r, |r| <= ln2 / 2
+    const int n = int(x / kLn2 + (x < 0 ? -0.5 : 0.5));
+    const double r = x - n * kLn2;
+    double term = 1;
+    double sum = 1;
+    for (int i = 1; i < 15; ++i) {
+        term *= r / i;
+        sum += term;
+    }
+    for (int i = 0; i < n; ++i) sum *= 2;
+    for (int i = 0; i > n; --i) sum /= 2;
+    return sum;
+}
+
+constexpr double pow(double x, double p)
+{
+    return x <= 0 ? 0 : exp(p * ln(x));
+}
+
+constexpr int clampInt(int v, int lo, int hi)
+{
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+}
+
+// 감마 → 대비(중간값 기준 기울기) → 밝기(오프셋) 순서
+//    gammaPermille: 감마 * 1000 (1000 = 변화 없음, 최소 50)
+//    brightness / contrast: -100 ~ +100
+constexpr Table make(int gammaPermille, int brightness, int contrast)
+{
+    const double invGamma = 1000.0 / (gammaPermille < 50 ? 50 : gammaPermille);
+    const double slope = (100.0 + detail::clampInt(contrast, -100, 100)) / 100.0;
+    const double offset = detail::clampInt(brightness, -100, 100) * 1.28;
+
+    Table table{};
+    for (int v = 0; v < 256; ++v) {
+        double x = v / 255.0;
+        if (gammaPermille != 1000) x = detail::pow(x, invGamma);
+        x = ((x - 0.5) * slope + 0.5) * 255.0 + offset;
+        table.v[v] = uint8_t(x <= 0 ? 0 : (x >= 255 ? 255 : int(x + 0.5)));
+    }
+    return table;
+}
+
+// 컴파일 시 생성되는 표 (예: ToneLut::kTable<2200, 0, 0> = 감마 2.2)
+template <int GammaPermille, int Brightness, int Contrast>
+inline constexpr Table kTable = make(GammaPermille, Brightness, Contrast);
+
+// 미리 생성된 표가 있으면 그대로, 없으면 캐시에서 (스레드 안전)
+Table lookup(double gamma, int brightness, int contrast);
+
+}
+
+#endif // TONELUT_H
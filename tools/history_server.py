@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+"""카메라 이력 API 대용 서버 (페이지 수집 테스트용)
+
+    python3 tools/history_server.py --events 20000
+    → https://127.0.0.1:8443/api/{detections,trespass,fall}?since=<yyyy-MM-dd HH:mm:ss>&limit=<N>
+
+- since는 제외 조건 (그 시각 이후만), 응답은 시각 오름차순 + has_more
+- 페이지 끝이 같은 초의 중간이면 그 초가 끝날 때까지 포함 (클라이언트 커서가 초 단위)
+- --legacy: since/limit을 무시하고 전체를 최신 순 1개 배열로 (구 펌웨어 흉내)
+- 인증서가 없으면 openssl로 자체 서명 인증서를 만듦 (클라이언트는 SSL 오류 무시)
+"""
+
+import argparse
+import bisect
+import json
+import os
+import random
+import ssl
+import subprocess
+import time
+from datetime import datetime, timedelta
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import parse_qs, urlparse
+
+TIME_FORMAT = "%Y-%m-%d %H:%M:%S"
+ENDPOINTS = ("detections", "trespass", "fall")
+
+
+def make_history(endpoint, count, seed):
+    """최근 count건, 평균 20초 간격, 같은 초 여러 건 포함"""
+    rng = random.Random(f"{seed}-{endpoint}")
+    now = datetime.now().replace(microsecond=0)
+    t = now - timedelta(seconds=count * 20)
+    items = []
+    for i in range(count):
+        if rng.random() > 0.2:   # 20%는 직전 이벤트와 같은 초
+            t += timedelta(seconds=rng.randint(1, 39))
+        item = {
+            "timestamp": t.strftime(TIME_FORMAT),
+            "image_path": f"../images/{endpoint}/{i:06d}.jpg",
+        }
+        if endpoint == "detections":
+            person = rng.randint(1, 4)
+            item.update(person_count=person,
+                        helmet_count=rng.randint(0, person),
+                        safety_vest_count=rng.randint(0, person),
+                        avg_confidence=round(rng.uniform(0.5, 0.99), 2))
+        else:
+            item["count"] = rng.randint(1, 3)
+        items.append(item)
+    return items
+
+
+def page(items, keys, since, limit):
+    start = bisect.bisect_right(keys, since) if since else 0
+    end = min(start + limit, len(items))
+    while 0 < end < len(items) and keys[end] == keys[end - 1]:   # 같은 초는 자르지 않음
+        end += 1
+    return items[start:end], end < len(items)
+
+
+class Handler(BaseHTTPRequestHandler):
+    history = {}
+    keys = {}
+    legacy = False
+    delay = 0.0
+
+    def do_GET(self):
+        url = urlparse(self.path)
+        endpoint = url.path.rsplit("/", 1)[-1]
+        if not url.path.startswith("/api/") or endpoint not in self.history:
+            self.send_error(404)
+            return
+
+        items, keys = self.history[endpoint], self.keys[endpoint]
+        if self.legacy:
+            body = {endpoint: list(reversed(items))}
+        else:
+            query = parse_qs(url.query)
+            since = query.get("since", [""])[0]
+            try:
+                limit = max(1, min(int(query.get("limit", ["500"])[0]), 5000))
+            except ValueError:
+                self.send_error(400, "bad limit")
+                return
+            chunk, has_more = page(items, keys, since, limit)
+            body = {endpoint: chunk, "has_more": has_more}
+
+        if self.delay:
+            time.sleep(self.delay)
+        payload = json.dumps(body, ensure_ascii=False).encode()
+        self.send_response(200)
+        self.send_header("Content-Type", "application/json")
+        self.send_header("Content-Length", str(len(payload)))
+        self.end_headers()
+        self.wfile.write(payload)
+
+
+def ensure_certificate(directory):
+    cert = os.path.join(directory, "history_server.crt")
+    key = os.path.join(directory, "history_server.key")
+    if not (os.path.exists(cert) and os.path.exists(key)):
+        subprocess.run(["openssl", "req", "-x509", "-newkey", "rsa:2048", "-nodes", "-days", "365",
+                        "-subj", "/CN=localhost", "-keyout", key, "-out", cert],
+                       check=True, capture_output=True)
+    return cert, key
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--host", default="0.0.0.0")
+    parser.add_argument("--port", type=int, default=8443)
+    parser.add_argument("--events", type=int, default=5000, help="기능별 이벤트 수")
+    parser.add_argument("--seed", default="cctv")
+    parser.add_argument("--delay", type=float, default=0.0, help="응답 지연(초), 동시 요청 제한 확인용")
+    parser.add_argument("--legacy", action="store_true")
+    parser.add_argument("--cert-dir", default=os.path.dirname(os.path.abspath(__file__)))
+    args = parser.parse_args()
+
+    for endpoint in ENDPOINTS:
+        Handler.history[endpoint] = make_history(endpoint, args.events, args.seed)
+        Handler.keys[endpoint] = [item["timestamp"] for item in Handler.history[endpoint]]
+    Handler.legacy = args.legacy
+    Handler.delay = args.delay
+
+    server = ThreadingHTTPServer((args.host, args.port), Handler)
+    context = ssl.SSLContext(ssl.PROTOCOL_TLS_SERVER)
+    context.load_cert_chain(*ensure_certificate(args.cert_dir))
+    server.socket = context.wrap_socket(server.socket, server_side=True)
+    print(f"history server: https://{args.host}:{args.port}/api/{{{','.join(ENDPOINTS)}}} "
+          f"({args.events}건씩{', legacy' if args.legacy else ''})")
+    server.serve_forever()
+
+
+if __name__ == "__main__":
+    main()
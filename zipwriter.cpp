@@ -0,0 +1,164 @@
+#include "zipwriter.h"
+
+#include <QIODevice>
+#include <QtEndian>
+
+#include <array>
+
+namespace {
+constexpr qint64 maxZipSize = 0xFFFFFFFFLL;
+constexpr int maxEntries = 0xFFFF;
+constexpr qint64 copyBlock = 256 * 1024;
+
+constexpr std::array<quint32, 256> makeCrcTable()
+{
+    std::array<quint32, 256> table{};
+    for (quint32 i = 0; i < 256; ++i) {
+        quint32 c = i;
+        for (int k = 0; k < 8; ++k)
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        table[i] = c;
+    }
+    return table;
+}
+constexpr std::array<quint32, 256> crcTable = makeCrcTable();
+
+void put16(QByteArray &out, quint16 value)
+{
+    char bytes[2];
+    qToLittleEndian(value, bytes);
+    out.append(bytes, 2);
+}
+
+void put32(QByteArray &out, quint32 value)
+{
+    char bytes[4];
+    qToLittleEndian(value, bytes);
+    out.append(bytes, 4);
+}
+
+// 1980-01-01 00:00 (DOS 시각, 의미 있는 시각은 파일명/표에 있음)
+constexpr quint16 dosTime = 0;
+constexpr quint16 dosDate = (0 << 9) | (1 << 5) | 1;
+constexpr quint16 utf8Flag = 0x0800;   // 한글 파일명
+}
+
+ZipWriter::ZipWriter(QIODevice *device)
+    : device(device)
+{
+}
+
+quint32 ZipWriter::crc32(quint32 crc, const char *data, qint64 size)
+{
+    crc = ~crc;
+    for (qint64 i = 0; i < size; ++i)
+        crc = crcTable[(crc ^ quint8(data[i])) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+bool ZipWriter::fail(const QString &message)
+{
+    if (error.isEmpty()) error = message;
+    return false;
+}
+
+bool ZipWriter::write(const QByteArray &bytes)
+{
+    if (device->write(bytes) != bytes.size())
+        return fail(device->errorString());
+    position += bytes.size();
+    return true;
+}
+
+bool ZipWriter::writeHeader(const QByteArray &name, quint32 crc, qint64 size)
+{
+    if (!error.isEmpty()) return false;
+    if (entries.size() >= maxEntries) return fail(QStringLiteral("ZIP 항목 수 한도(65535) 초과"));
+    if (position + 30 + name.size() + size > maxZipSize) return fail(QStringLiteral("ZIP 크기 한도(4GB) 초과"));
+
+    entries.append({name, crc, quint32(size), quint32(position)});
+
+    QByteArray header;
+    header.reserve(30 + name.size());
+    put32(header, 0x04034b50);
+    put16(header, 20);              // 필요 버전 2.0
+    put16(header, utf8Flag);
+    put16(header, 0);               // stored
+    put16(header, dosTime);
+    put16(header, dosDate);
+    put32(header, crc);
+    put32(header, quint32(size));   // 압축 크기
+    put32(header, quint32(size));   // 원래 크기
+    put16(header, quint16(name.size()));
+    put16(header, 0);               // extra
+    header.append(name);
+    return write(header);
+}
+
+bool ZipWriter::addFile(const QString &name, const QByteArray &data)
+{
+    const QByteArray utf8 = name.toUtf8();
+    if (!writeHeader(utf8, crc32(0, data.constData(), data.size()), data.size())) return false;
+    return write(data);
+}
+
+bool ZipWriter::addFile(const QString &name, QIODevice *source)
+{
+    // 1차: CRC (블록 단위라 파일 크기와 무관하게 메모리 일정)
+    if (!source->seek(0)) return fail(source->errorString());
+    quint32 crc = 0;
+    qint64 size = 0;
+    QByteArray block;
+    while (!(block = source->read(copyBlock)).isEmpty()) {
+        crc = crc32(crc, block.constData(), block.size());
+        size += block.size();
+    }
+
+    // 2차: 복사
+    if (!writeHeader(name.toUtf8(), crc, size)) return false;
+    if (!source->seek(0)) return fail(source->errorString());
+    while (!(block = source->read(copyBlock)).isEmpty()) {
+        if (!write(block)) return false;
+    }
+    return true;
+}
+
+bool ZipWriter::finish()
+{
+    if (!error.isEmpty()) return false;
+
+    const qint64 directoryOffset = position;
+    QByteArray directory;
+    for (const Entry &entry : entries) {
+        put32(directory, 0x02014b50);
+        put16(directory, 20);           // 작성 버전
+        put16(directory, 20);           // 필요 버전
+        put16(directory, utf8Flag);
+        put16(directory, 0);            // stored
+        put16(directory, dosTime);
+        put16(directory, dosDate);
+        put32(directory, entry.crc);
+        put32(directory, entry.size);
+        put32(directory, entry.size);
+        put16(directory, quint16(entry.name.size()));
+        put16(directory, 0);            // extra
+        put16(directory, 0);            // comment
+        put16(directory, 0);            // disk
+        put16(directory, 0);            // 내부 속성
+        put32(directory, 0);            // 외부 속성
+        put32(directory, entry.offset);
+        directory.append(entry.name);
+    }
+    if (directoryOffset + directory.size() + 22 > maxZipSize) return fail(QStringLiteral("ZIP 크기 한도(4GB) 초과"));
+
+    QByteArray end;
+    put32(end, 0x06054b50);
+    put16(end, 0);
+    put16(end, 0);
+    put16(end, quint16(entries.size()));
+    put16(end, quint16(entries.size()));
+    put32(end, quint32(directory.size()));
+    put32(end, quint32(directoryOffset));
+    put16(end, 0);
+    return write(directory) && write(end);
+}
@@ -0,0 +1,46 @@
+#ifndef ZIPWRITER_H
+#define ZIPWRITER_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+class QIODevice;
+
+// ✅ 최소 ZIP 작성기 (무압축 stored, 순차 기록)
+//    스냅샷 JPEG은 이미 압축돼 있어 deflate 이득이 거의 없음 → 압축 없이 CRC만 계산
+//    항목은 하나씩 바로 장치에 쓰고, 중앙 디렉터리(항목당 이름 + 오프셋)만 메모리에 보관
+//    ZIP64 미지원: 항목 65535개 / 전체 4GB 넘으면 실패
+//    스레드 안전하지 않음 (한 번에 한 스레드에서만 호출)
+class ZipWriter
+{
+public:
+    explicit ZipWriter(QIODevice *device);
+
+    bool addFile(const QString &name, const QByteArray &data);
+    bool addFile(const QString &name, QIODevice *source);   // 처음부터 끝까지 두 번 읽음 (CRC → 복사)
+    bool finish();                                          // 중앙 디렉터리 기록
+
+    QString errorString() const { return error; }
+
+    static quint32 crc32(quint32 crc, const char *data, qint64 size);
+
+private:
+    struct Entry {
+        QByteArray name;
+        quint32 crc;
+        quint32 size;
+        quint32 offset;
+    };
+
+    bool writeHeader(const QByteArray &name, quint32 crc, qint64 size);
+    bool write(const QByteArray &bytes);
+    bool fail(const QString &message);
+
+    QIODevice *device;
+    QVector<Entry> entries;
+    qint64 position = 0;
+    QString error;
+};
+
+#endif // ZIPWRITER_H